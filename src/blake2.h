@@ -12,6 +12,8 @@
 #ifndef CHOCOBO1_BLAKE2_H
 #define CHOCOBO1_BLAKE2_H
 
+#include "x86_simd.h"
+
 #include <array>
 #include <cassert>
 #include <climits>
@@ -249,6 +251,102 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_BLAKE2B_AVX2_IMPL
+#define CHOCOBO1_HASH_BLAKE2B_AVX2_IMPL
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline void blake2bCompressAvx2(uint64_t (&state)[8], const uint8_t *block, const uint64_t counterLow, const uint64_t counterHigh, const bool isFinal, const bool isLastNode)
+	{
+		// https://github.com/BLAKE2/BLAKE2/blob/master/sse/blake2b-round.h
+		// each row of the 4x4 state matrix is held in a register, the G function runs on the 4 columns at once,
+		// then the rows are rotated so the diagonals line up as columns
+
+		const __m256i rotr24 = _mm256_setr_epi8(
+			3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+			3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+		const __m256i rotr16 = _mm256_setr_epi8(
+			2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+			2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+
+		// each 128-bit lane holds the message words (2 * i, 2 * i + 1)
+		__m256i m[8] = {};
+		for (int i = 0; i < 8; ++i)
+			m[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + (i * 16))));
+
+		const __m256i h0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + 0));
+		const __m256i h1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + 4));
+		__m256i row1 = h0;
+		__m256i row2 = h1;
+		__m256i row3 = _mm256_setr_epi64x(0x6a09e667f3bcc908, static_cast<int64_t>(0xbb67ae8584caa73b), 0x3c6ef372fe94f82b, static_cast<int64_t>(0xa54ff53a5f1d36f1));
+		__m256i row4 = _mm256_xor_si256(
+			_mm256_setr_epi64x(0x510e527fade682d1, static_cast<int64_t>(0x9b05688c2b3e6c1f), 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179),
+			_mm256_setr_epi64x(static_cast<int64_t>(counterLow), static_cast<int64_t>(counterHigh), (isFinal ? -1 : 0), (isLastNode ? -1 : 0)));
+
+		#ifdef blake2bAvx2G
+		#error "macro name clash"
+		#else
+		#define blake2bAvx2G(x, y) \
+			row1 = _mm256_add_epi64(_mm256_add_epi64(row1, row2), x); \
+			row4 = _mm256_shuffle_epi32(_mm256_xor_si256(row4, row1), _MM_SHUFFLE(2, 3, 0, 1)); \
+			row3 = _mm256_add_epi64(row3, row4); \
+			row2 = _mm256_shuffle_epi8(_mm256_xor_si256(row2, row3), rotr24); \
+			row1 = _mm256_add_epi64(_mm256_add_epi64(row1, row2), y); \
+			row4 = _mm256_shuffle_epi8(_mm256_xor_si256(row4, row1), rotr16); \
+			row3 = _mm256_add_epi64(row3, row4); \
+			row2 = _mm256_xor_si256(row2, row3); \
+			row2 = _mm256_or_si256(_mm256_srli_epi64(row2, 63), _mm256_add_epi64(row2, row2));
+
+		// message words (x, y) of a 128-bit lane, the indices are constants so only 1 instruction remains
+		#ifdef blake2bAvx2Pair
+		#error "macro name clash"
+		#else
+		#define blake2bAvx2Pair(x, y) \
+			((((x) % 2) == 0) \
+				? ((((y) % 2) == 0) ? _mm256_unpacklo_epi64(m[(x) / 2], m[(y) / 2]) : _mm256_blend_epi32(m[(x) / 2], m[(y) / 2], 0xCC)) \
+				: ((((y) % 2) == 0) ? _mm256_alignr_epi8(m[(y) / 2], m[(x) / 2], 8) : _mm256_unpackhi_epi64(m[(x) / 2], m[(y) / 2])))
+
+		#ifdef blake2bAvx2Round
+		#error "macro name clash"
+		#else
+		#define blake2bAvx2Round(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15) \
+			blake2bAvx2G( \
+				_mm256_blend_epi32(blake2bAvx2Pair(s0, s2), blake2bAvx2Pair(s4, s6), 0xF0), \
+				_mm256_blend_epi32(blake2bAvx2Pair(s1, s3), blake2bAvx2Pair(s5, s7), 0xF0)); \
+			row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0, 3, 2, 1)); /* diagonalize */ \
+			row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2)); \
+			row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2, 1, 0, 3)); \
+			blake2bAvx2G( \
+				_mm256_blend_epi32(blake2bAvx2Pair(s8, s10), blake2bAvx2Pair(s12, s14), 0xF0), \
+				_mm256_blend_epi32(blake2bAvx2Pair(s9, s11), blake2bAvx2Pair(s13, s15), 0xF0)); \
+			row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2, 1, 0, 3)); /* undiagonalize */ \
+			row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2)); \
+			row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0, 3, 2, 1));
+
+		blake2bAvx2Round( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15);
+		blake2bAvx2Round(14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3);
+		blake2bAvx2Round(11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4);
+		blake2bAvx2Round( 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8);
+		blake2bAvx2Round( 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13);
+		blake2bAvx2Round( 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9);
+		blake2bAvx2Round(12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11);
+		blake2bAvx2Round(13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10);
+		blake2bAvx2Round( 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5);
+		blake2bAvx2Round(10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0);
+		blake2bAvx2Round( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15);
+		blake2bAvx2Round(14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3);
+		#undef blake2bAvx2Round
+		#endif
+		#undef blake2bAvx2Pair
+		#endif
+		#undef blake2bAvx2G
+		#endif
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state + 0), _mm256_xor_si256(h0, _mm256_xor_si256(row1, row3)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state + 4), _mm256_xor_si256(h1, _mm256_xor_si256(row2, row4)));
+	}
+#endif
+#endif
+
 
 namespace Blake2_NS
 {
@@ -269,7 +367,21 @@ namespace Blake2_NS
 #endif
 
 
+			struct ParameterBlock
+			{
+				// tree hashing parameters, the defaults are for sequential hashing
+				uint8_t fanout = 1;
+				uint8_t depth = 1;
+				uint32_t leafLength = 0;
+				uint64_t nodeOffset = 0;
+				uint8_t nodeDepth = 0;
+				uint8_t innerLength = 0;
+				bool lastNode = false;  // not in the parameter block, it is set for the last node of each tree level
+			};
+
+
 			constexpr Blake2();
+			constexpr explicit Blake2(const ParameterBlock &parameters);
 
 			constexpr void reset();
 			CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
@@ -310,6 +422,7 @@ namespace Blake2_NS
 
 			Buffer<Byte, BLOCK_SIZE> m_buffer;
 			Uint128 m_sizeCounter;
+			ParameterBlock m_parameters;
 
 			uint64_t m_h[8] = {};
 			const uint64_t m_initializationVector[8] =
@@ -359,6 +472,13 @@ namespace Blake2_NS
 		reset();
 	}
 
+	constexpr Blake2::Blake2(const ParameterBlock &parameters)
+		: m_parameters(parameters)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
 	constexpr void Blake2::reset()
 	{
 		m_buffer.clear();
@@ -367,7 +487,13 @@ namespace Blake2_NS
 		for (int i = 0; i < 8; ++i)
 			m_h[i] = m_initializationVector[i];
 
-		m_h[0] ^= (0x01010000 ^ (0 << 8) ^ 64);
+		m_h[0] ^= (static_cast<uint64_t>(m_parameters.leafLength) << 32)
+			^ (static_cast<uint64_t>(m_parameters.depth) << 24)
+			^ (static_cast<uint64_t>(m_parameters.fanout) << 16)
+			^ (0 << 8)
+			^ 64;
+		m_h[1] ^= m_parameters.nodeOffset;
+		m_h[2] ^= (static_cast<uint64_t>(m_parameters.innerLength) << 8) ^ m_parameters.nodeDepth;
 	}
 
 	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2& Blake2::finalize()
@@ -507,6 +633,14 @@ namespace Blake2_NS
 
 			m_sizeCounter += (BLOCK_SIZE - paddingLen);
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+			if (!isConstantEvaluated() && cpuFeatures().avx2)
+			{
+				blake2bCompressAvx2(m_h, (data.data() + (iter * BLOCK_SIZE)), m_sizeCounter.low(), m_sizeCounter.high(), isFinal, (isFinal && m_parameters.lastNode));
+				continue;
+			}
+#endif
+
 			uint64_t v[16] =
 			{
 				m_h[0], m_h[1], m_h[2], m_h[3], m_h[4], m_h[5], m_h[6], m_h[7],
@@ -514,7 +648,7 @@ namespace Blake2_NS
 				m_initializationVector[4] ^ m_sizeCounter.low(),
 				m_initializationVector[5] ^ m_sizeCounter.high(),
 				isFinal ? ~m_initializationVector[6] : m_initializationVector[6],
-				m_initializationVector[7]
+				(isFinal && m_parameters.lastNode) ? ~m_initializationVector[7] : m_initializationVector[7]
 			};
 
 			#ifdef blakeMix
@@ -0,0 +1,274 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_BLAKE2BP_H
+#define CHOCOBO1_BLAKE2BP_H
+
+#include "blake2.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// Blake2bp();
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+namespace Blake2bp_NS
+{
+	class Blake2bp
+	{
+		// BLAKE2bp: 4 BLAKE2b leaves take turns on 128-byte blocks, the root hashes the leaf digests
+		// https://blake2.net/blake2.pdf, section 2.10
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, 64>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr Blake2bp();
+
+			constexpr void reset();
+			CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2bp& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			Blake2bp& addData(Span<const Byte> inData);  // large inputs hash the leaves on the shared worker threads
+			Blake2bp& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			Blake2bp& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			Blake2bp& addData(const T (&array)[N]);
+			template <typename T>
+			Blake2bp& addData(Span<T> inSpan);
+
+			friend constexpr bool operator==(const Blake2bp &left, const Blake2bp &right)
+			{
+				for (int i = 0; i < LEAVES; ++i)
+				{
+					if (left.m_leaves[i] != right.m_leaves[i])
+						return false;
+				}
+				return (left.m_root == right.m_root);
+			}
+			friend constexpr bool operator!=(const Blake2bp &left, const Blake2bp &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static constexpr int LEAVES = 4;
+			static constexpr int BLOCK_SIZE = 128;
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller inputs aren't worth the tasks
+
+			static constexpr Blake2::ParameterBlock nodeParameters(int nodeOffset, int nodeDepth, bool lastNode);
+			void addLeafData(int leaf, Span<const Byte> data, uint64_t offset);
+
+			Blake2 m_leaves[LEAVES] =
+			{
+				Blake2(nodeParameters(0, 0, false)),
+				Blake2(nodeParameters(1, 0, false)),
+				Blake2(nodeParameters(2, 0, false)),
+				Blake2(nodeParameters(3, 0, true))
+			};
+			Blake2 m_root = Blake2(nodeParameters(0, 1, true));
+			uint64_t m_sizeCounter = 0;
+	};
+
+
+	//
+	constexpr Blake2bp::Blake2bp()
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
+	constexpr void Blake2bp::reset()
+	{
+		for (auto &leaf : m_leaves)
+			leaf.reset();
+		m_root.reset();
+		m_sizeCounter = 0;
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2bp& Blake2bp::finalize()
+	{
+		for (auto &leaf : m_leaves)
+			m_root.addData(leaf.finalize().toArray());
+		m_root.finalize();
+
+		return (*this);
+	}
+
+	inline std::string Blake2bp::toString() const
+	{
+		return m_root.toString();
+	}
+
+	inline std::vector<Blake2bp::Byte> Blake2bp::toVector() const
+	{
+		return m_root.toVector();
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2bp::ResultArrayType Blake2bp::toArray() const
+	{
+		return m_root.toArray();
+	}
+
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2bp::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	inline Blake2bp& Blake2bp::addData(const Span<const Byte> inData)
+	{
+		const uint64_t offset = m_sizeCounter;
+		m_sizeCounter += static_cast<uint64_t>(inData.size());
+
+		if (static_cast<std::size_t>(inData.size()) < MIN_PARALLEL_SIZE)
+		{
+			for (int i = 0; i < LEAVES; ++i)
+				addLeafData(i, inData, offset);
+			return (*this);
+		}
+
+		threadPool().parallelFor(LEAVES, [this, &inData, offset](const std::size_t leaf) -> void
+		{
+			addLeafData(static_cast<int>(leaf), inData, offset);
+		});
+
+		return (*this);
+	}
+
+	inline Blake2bp& Blake2bp::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	Blake2bp& Blake2bp::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	Blake2bp& Blake2bp::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	Blake2bp& Blake2bp::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	constexpr Blake2::ParameterBlock Blake2bp::nodeParameters(const int nodeOffset, const int nodeDepth, const bool lastNode)
+	{
+		Blake2::ParameterBlock ret;
+		ret.fanout = LEAVES;
+		ret.depth = 2;
+		ret.nodeOffset = static_cast<uint64_t>(nodeOffset);
+		ret.nodeDepth = static_cast<uint8_t>(nodeDepth);
+		ret.innerLength = 64;
+		ret.lastNode = lastNode;
+		return ret;
+	}
+
+	inline void Blake2bp::addLeafData(const int leaf, const Span<const Byte> data, const uint64_t offset)
+	{
+		// `offset` is the position of `data` in the whole message, it decides which leaf a block goes to
+		std::size_t processed = 0;
+		while (processed < static_cast<std::size_t>(data.size()))
+		{
+			const uint64_t position = offset + processed;
+			const std::size_t len = std::min(static_cast<std::size_t>(BLOCK_SIZE - (position % BLOCK_SIZE)), (static_cast<std::size_t>(data.size()) - processed));
+
+			if (static_cast<int>((position / BLOCK_SIZE) % LEAVES) == leaf)
+				m_leaves[leaf].addData(data.subspan(processed, len));
+			processed += len;
+		}
+	}
+}
+}
+
+	using Blake2bp = Hash::Blake2bp_NS::Blake2bp;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::Blake2bp>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Blake2bp &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_BLAKE2BP_H
@@ -12,6 +12,8 @@
 #ifndef CHOCOBO1_BLAKE2S_H
 #define CHOCOBO1_BLAKE2S_H
 
+#include "x86_simd.h"
+
 #include <array>
 #include <cassert>
 #include <climits>
@@ -186,6 +188,101 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_BLAKE2S_SSE41_IMPL
+#define CHOCOBO1_HASH_BLAKE2S_SSE41_IMPL
+	X86_TARGET_CHOCOBO1_HASH("sse4.1")
+	inline void blake2sCompressSse41(uint32_t (&state)[8], const uint8_t *block, const uint64_t counter, const bool isFinal, const bool isLastNode)
+	{
+		// https://github.com/BLAKE2/BLAKE2/blob/master/sse/blake2s-round.h
+		// each row of the 4x4 state matrix is held in a register, the G function runs on the 4 columns at once,
+		// then the rows are rotated so the diagonals line up as columns
+
+		const __m128i rotr16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+		const __m128i rotr8 = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+
+		const __m128i m[4] =
+		{
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 0)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48))
+		};
+
+		const __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 0));
+		const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+		__m128i row1 = h0;
+		__m128i row2 = h1;
+		__m128i row3 = _mm_setr_epi32(0x6a09e667, static_cast<int>(0xbb67ae85), 0x3c6ef372, static_cast<int>(0xa54ff53a));
+		__m128i row4 = _mm_xor_si128(
+			_mm_setr_epi32(0x510e527f, static_cast<int>(0x9b05688c), 0x1f83d9ab, 0x5be0cd19),
+			_mm_setr_epi32(static_cast<int>(counter), static_cast<int>(counter >> 32), (isFinal ? -1 : 0), (isLastNode ? -1 : 0)));
+
+		#ifdef blake2sSse41G
+		#error "macro name clash"
+		#else
+		#define blake2sSse41G(x, y) \
+			row1 = _mm_add_epi32(_mm_add_epi32(row1, row2), x); \
+			row4 = _mm_shuffle_epi8(_mm_xor_si128(row4, row1), rotr16); \
+			row3 = _mm_add_epi32(row3, row4); \
+			row2 = _mm_xor_si128(row2, row3); \
+			row2 = _mm_or_si128(_mm_srli_epi32(row2, 12), _mm_slli_epi32(row2, 20)); \
+			row1 = _mm_add_epi32(_mm_add_epi32(row1, row2), y); \
+			row4 = _mm_shuffle_epi8(_mm_xor_si128(row4, row1), rotr8); \
+			row3 = _mm_add_epi32(row3, row4); \
+			row2 = _mm_xor_si128(row2, row3); \
+			row2 = _mm_or_si128(_mm_srli_epi32(row2, 7), _mm_slli_epi32(row2, 25));
+
+		// gather message words (a, b, c, d), the indices are constants so the blends of unused sources fold away
+		#ifdef blake2sSse41Msg
+		#error "macro name clash"
+		#else
+		#define blake2sSse41Msg(a, b, c, d) \
+			_mm_blend_epi16(_mm_blend_epi16(_mm_blend_epi16( \
+				_mm_shuffle_epi32(m[0], _MM_SHUFFLE(((d) % 4), ((c) % 4), ((b) % 4), ((a) % 4))), \
+				_mm_shuffle_epi32(m[1], _MM_SHUFFLE(((d) % 4), ((c) % 4), ((b) % 4), ((a) % 4))), \
+				((((a) / 4) == 1) * 0x03) | ((((b) / 4) == 1) * 0x0C) | ((((c) / 4) == 1) * 0x30) | ((((d) / 4) == 1) * 0xC0)), \
+				_mm_shuffle_epi32(m[2], _MM_SHUFFLE(((d) % 4), ((c) % 4), ((b) % 4), ((a) % 4))), \
+				((((a) / 4) == 2) * 0x03) | ((((b) / 4) == 2) * 0x0C) | ((((c) / 4) == 2) * 0x30) | ((((d) / 4) == 2) * 0xC0)), \
+				_mm_shuffle_epi32(m[3], _MM_SHUFFLE(((d) % 4), ((c) % 4), ((b) % 4), ((a) % 4))), \
+				((((a) / 4) == 3) * 0x03) | ((((b) / 4) == 3) * 0x0C) | ((((c) / 4) == 3) * 0x30) | ((((d) / 4) == 3) * 0xC0))
+
+		#ifdef blake2sSse41Round
+		#error "macro name clash"
+		#else
+		#define blake2sSse41Round(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15) \
+			blake2sSse41G(blake2sSse41Msg(s0, s2, s4, s6), blake2sSse41Msg(s1, s3, s5, s7)); \
+			row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(0, 3, 2, 1)); /* diagonalize */ \
+			row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1, 0, 3, 2)); \
+			row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(2, 1, 0, 3)); \
+			blake2sSse41G(blake2sSse41Msg(s8, s10, s12, s14), blake2sSse41Msg(s9, s11, s13, s15)); \
+			row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(2, 1, 0, 3)); /* undiagonalize */ \
+			row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1, 0, 3, 2)); \
+			row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(0, 3, 2, 1));
+
+		blake2sSse41Round( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15);
+		blake2sSse41Round(14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3);
+		blake2sSse41Round(11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4);
+		blake2sSse41Round( 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8);
+		blake2sSse41Round( 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13);
+		blake2sSse41Round( 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9);
+		blake2sSse41Round(12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11);
+		blake2sSse41Round(13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10);
+		blake2sSse41Round( 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5);
+		blake2sSse41Round(10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0);
+		#undef blake2sSse41Round
+		#endif
+		#undef blake2sSse41Msg
+		#endif
+		#undef blake2sSse41G
+		#endif
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(state + 0), _mm_xor_si128(h0, _mm_xor_si128(row1, row3)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_xor_si128(h1, _mm_xor_si128(row2, row4)));
+	}
+#endif
+#endif
+
 
 namespace Blake2s_NS
 {
@@ -206,7 +303,21 @@ namespace Blake2s_NS
 #endif
 
 
+			struct ParameterBlock
+			{
+				// tree hashing parameters, the defaults are for sequential hashing
+				uint8_t fanout = 1;
+				uint8_t depth = 1;
+				uint32_t leafLength = 0;
+				uint64_t nodeOffset = 0;  // only the lower 48 bits are used
+				uint8_t nodeDepth = 0;
+				uint8_t innerLength = 0;
+				bool lastNode = false;  // not in the parameter block, it is set for the last node of each tree level
+			};
+
+
 			constexpr Blake2s();
+			constexpr explicit Blake2s(const ParameterBlock &parameters);
 
 			constexpr void reset();
 			CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2s& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
@@ -247,6 +358,7 @@ namespace Blake2s_NS
 
 			Buffer<Byte, BLOCK_SIZE> m_buffer;
 			uint64_t m_sizeCounter = 0;
+			ParameterBlock m_parameters;
 
 			uint32_t m_h[8] = {};
 			const uint32_t m_initializationVector[8] =
@@ -293,6 +405,13 @@ namespace Blake2s_NS
 		reset();
 	}
 
+	constexpr Blake2s::Blake2s(const ParameterBlock &parameters)
+		: m_parameters(parameters)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
 	constexpr void Blake2s::reset()
 	{
 		m_buffer.clear();
@@ -301,7 +420,15 @@ namespace Blake2s_NS
 		for (int i = 0; i < 8; ++i)
 			m_h[i] = m_initializationVector[i];
 
-		m_h[0] ^= (0x01010000 ^ (0 << 8) ^ 32);
+		m_h[0] ^= (static_cast<uint32_t>(m_parameters.depth) << 24)
+			^ (static_cast<uint32_t>(m_parameters.fanout) << 16)
+			^ (0 << 8)
+			^ 32;
+		m_h[1] ^= m_parameters.leafLength;
+		m_h[2] ^= static_cast<uint32_t>(m_parameters.nodeOffset);
+		m_h[3] ^= (static_cast<uint32_t>(m_parameters.innerLength) << 24)
+			^ (static_cast<uint32_t>(m_parameters.nodeDepth) << 16)
+			^ (static_cast<uint32_t>(m_parameters.nodeOffset >> 32) & 0xFFFF);
 	}
 
 	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2s& Blake2s::finalize()
@@ -441,6 +568,14 @@ namespace Blake2s_NS
 
 			m_sizeCounter += (BLOCK_SIZE - paddingLen);
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+			if (!isConstantEvaluated() && cpuFeatures().sse41)
+			{
+				blake2sCompressSse41(m_h, (data.data() + (iter * BLOCK_SIZE)), m_sizeCounter, isFinal, (isFinal && m_parameters.lastNode));
+				continue;
+			}
+#endif
+
 			uint32_t v[16] =
 			{
 				m_h[0], m_h[1], m_h[2], m_h[3], m_h[4], m_h[5], m_h[6], m_h[7],
@@ -448,7 +583,7 @@ namespace Blake2s_NS
 				m_initializationVector[4] ^ ror<uint32_t>(m_sizeCounter, 0),
 				m_initializationVector[5] ^ ror<uint32_t>(m_sizeCounter, 32),
 				isFinal ? ~m_initializationVector[6] : m_initializationVector[6],
-				m_initializationVector[7]
+				(isFinal && m_parameters.lastNode) ? ~m_initializationVector[7] : m_initializationVector[7]
 			};
 
 			#ifdef blakeMix
@@ -0,0 +1,278 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_BLAKE2SP_H
+#define CHOCOBO1_BLAKE2SP_H
+
+#include "blake2s.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// Blake2sp();
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+namespace Blake2sp_NS
+{
+	class Blake2sp
+	{
+		// BLAKE2sp: 8 BLAKE2s leaves take turns on 64-byte blocks, the root hashes the leaf digests
+		// https://blake2.net/blake2.pdf, section 2.10
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, 32>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr Blake2sp();
+
+			constexpr void reset();
+			CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2sp& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			Blake2sp& addData(Span<const Byte> inData);  // large inputs hash the leaves on the shared worker threads
+			Blake2sp& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			Blake2sp& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			Blake2sp& addData(const T (&array)[N]);
+			template <typename T>
+			Blake2sp& addData(Span<T> inSpan);
+
+			friend constexpr bool operator==(const Blake2sp &left, const Blake2sp &right)
+			{
+				for (int i = 0; i < LEAVES; ++i)
+				{
+					if (left.m_leaves[i] != right.m_leaves[i])
+						return false;
+				}
+				return (left.m_root == right.m_root);
+			}
+			friend constexpr bool operator!=(const Blake2sp &left, const Blake2sp &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static constexpr int LEAVES = 8;
+			static constexpr int BLOCK_SIZE = 64;
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller inputs aren't worth the tasks
+
+			static constexpr Blake2s::ParameterBlock nodeParameters(int nodeOffset, int nodeDepth, bool lastNode);
+			void addLeafData(int leaf, Span<const Byte> data, uint64_t offset);
+
+			Blake2s m_leaves[LEAVES] =
+			{
+				Blake2s(nodeParameters(0, 0, false)),
+				Blake2s(nodeParameters(1, 0, false)),
+				Blake2s(nodeParameters(2, 0, false)),
+				Blake2s(nodeParameters(3, 0, false)),
+				Blake2s(nodeParameters(4, 0, false)),
+				Blake2s(nodeParameters(5, 0, false)),
+				Blake2s(nodeParameters(6, 0, false)),
+				Blake2s(nodeParameters(7, 0, true))
+			};
+			Blake2s m_root = Blake2s(nodeParameters(0, 1, true));
+			uint64_t m_sizeCounter = 0;
+	};
+
+
+	//
+	constexpr Blake2sp::Blake2sp()
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
+	constexpr void Blake2sp::reset()
+	{
+		for (auto &leaf : m_leaves)
+			leaf.reset();
+		m_root.reset();
+		m_sizeCounter = 0;
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2sp& Blake2sp::finalize()
+	{
+		for (auto &leaf : m_leaves)
+			m_root.addData(leaf.finalize().toArray());
+		m_root.finalize();
+
+		return (*this);
+	}
+
+	inline std::string Blake2sp::toString() const
+	{
+		return m_root.toString();
+	}
+
+	inline std::vector<Blake2sp::Byte> Blake2sp::toVector() const
+	{
+		return m_root.toVector();
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake2sp::ResultArrayType Blake2sp::toArray() const
+	{
+		return m_root.toArray();
+	}
+
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH Blake2sp::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	inline Blake2sp& Blake2sp::addData(const Span<const Byte> inData)
+	{
+		const uint64_t offset = m_sizeCounter;
+		m_sizeCounter += static_cast<uint64_t>(inData.size());
+
+		if (static_cast<std::size_t>(inData.size()) < MIN_PARALLEL_SIZE)
+		{
+			for (int i = 0; i < LEAVES; ++i)
+				addLeafData(i, inData, offset);
+			return (*this);
+		}
+
+		threadPool().parallelFor(LEAVES, [this, &inData, offset](const std::size_t leaf) -> void
+		{
+			addLeafData(static_cast<int>(leaf), inData, offset);
+		});
+
+		return (*this);
+	}
+
+	inline Blake2sp& Blake2sp::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	Blake2sp& Blake2sp::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	Blake2sp& Blake2sp::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	Blake2sp& Blake2sp::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	constexpr Blake2s::ParameterBlock Blake2sp::nodeParameters(const int nodeOffset, const int nodeDepth, const bool lastNode)
+	{
+		Blake2s::ParameterBlock ret;
+		ret.fanout = LEAVES;
+		ret.depth = 2;
+		ret.nodeOffset = static_cast<uint64_t>(nodeOffset);
+		ret.nodeDepth = static_cast<uint8_t>(nodeDepth);
+		ret.innerLength = 32;
+		ret.lastNode = lastNode;
+		return ret;
+	}
+
+	inline void Blake2sp::addLeafData(const int leaf, const Span<const Byte> data, const uint64_t offset)
+	{
+		// `offset` is the position of `data` in the whole message, it decides which leaf a block goes to
+		std::size_t processed = 0;
+		while (processed < static_cast<std::size_t>(data.size()))
+		{
+			const uint64_t position = offset + processed;
+			const std::size_t len = std::min(static_cast<std::size_t>(BLOCK_SIZE - (position % BLOCK_SIZE)), (static_cast<std::size_t>(data.size()) - processed));
+
+			if (static_cast<int>((position / BLOCK_SIZE) % LEAVES) == leaf)
+				m_leaves[leaf].addData(data.subspan(processed, len));
+			processed += len;
+		}
+	}
+}
+}
+
+	using Blake2sp = Hash::Blake2sp_NS::Blake2sp;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::Blake2sp>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Blake2sp &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_BLAKE2SP_H
@@ -0,0 +1,1124 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_BLAKE3_H
+#define CHOCOBO1_BLAKE3_H
+
+#include "thread_pool.h"
+#include "x86_simd.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// Blake3();
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+#ifndef CONSTEXPR_CPP17_CHOCOBO1_HASH
+#if __cplusplus >= 201703L
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH constexpr
+#else
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+	using IndexType = std::size_t;
+#else
+	using IndexType = gsl::index;
+#endif
+
+#ifndef CHOCOBO1_HASH_BUFFER_IMPL
+#define CHOCOBO1_HASH_BUFFER_IMPL
+	template <typename T, IndexType N>
+	class Buffer
+	{
+		public:
+			using value_type = T;
+			using index_type = IndexType;
+			using size_type = std::size_t;
+
+			constexpr Buffer() = default;
+
+			CONSTEXPR_CPP17_CHOCOBO1_HASH Buffer(const std::initializer_list<T> initList)
+			{
+#if !defined(NDEBUG)
+				// check if out-of-bounds
+				static_cast<void>(m_array.at(m_dataEndIdx + initList.size() - 1));
+#endif
+
+				for (const auto &i : initList)
+				{
+					m_array[m_dataEndIdx] = i;
+					++m_dataEndIdx;
+				}
+			}
+
+			template <typename InputIt>
+			constexpr Buffer(const InputIt first, const InputIt last)
+			{
+				for (InputIt iter = first; iter != last; ++iter)
+				{
+					this->fill(*iter);
+				}
+			}
+
+			constexpr T& operator[](const index_type pos)
+			{
+				return m_array[pos];
+			}
+
+			constexpr T operator[](const index_type pos) const
+			{
+				return m_array[pos];
+			}
+
+			CONSTEXPR_CPP17_CHOCOBO1_HASH void fill(const T &value, const index_type count = 1)
+			{
+#if !defined(NDEBUG)
+				// check if out-of-bounds
+				static_cast<void>(m_array.at(m_dataEndIdx + count - 1));
+#endif
+
+				for (index_type i = 0; i < count; ++i)
+				{
+					m_array[m_dataEndIdx] = value;
+					++m_dataEndIdx;
+				}
+			}
+
+			template <typename InputIt>
+			constexpr void push_back(const InputIt first, const InputIt last)
+			{
+				for (InputIt iter = first; iter != last; ++iter)
+				{
+					this->fill(*iter);
+				}
+			}
+
+			constexpr void clear()
+			{
+				m_array = {};
+				m_dataEndIdx = 0;
+			}
+
+			constexpr bool empty() const
+			{
+				return (m_dataEndIdx == 0);
+			}
+
+			constexpr size_type size() const
+			{
+				return m_dataEndIdx;
+			}
+
+			constexpr const T* data() const
+			{
+				return m_array.data();
+			}
+
+		private:
+			std::array<T, N> m_array {};
+			index_type m_dataEndIdx = 0;
+	};
+#endif
+
+#ifndef CHOCOBO1_HASH_ROR_IMPL
+#define CHOCOBO1_HASH_ROR_IMPL
+	template <typename R, typename T>
+	constexpr R ror(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<R>::value, "");
+		static_assert(std::is_unsigned<T>::value, "");
+		return static_cast<R>(x >> s);
+	}
+#endif
+
+#ifndef CHOCOBO1_HASH_ROTR_IMPL
+#define CHOCOBO1_HASH_ROTR_IMPL
+	template <typename T>
+	constexpr T rotr(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+		if (s == 0)
+			return x;
+		return ((x >> s) | (x << ((sizeof(T) * 8) - s)));
+	}
+#endif
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_BLAKE3_AVX2_IMPL
+#define CHOCOBO1_HASH_BLAKE3_AVX2_IMPL
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline void blake3HashEightAvx2(const uint8_t *const *inputs, const std::size_t blocks, const uint32_t (&key)[8], const uint64_t counter
+		, const bool incrementCounter, const uint32_t flags, const uint32_t flagsStart, const uint32_t flagsEnd, uint8_t *out)
+	{
+		// https://github.com/BLAKE3-team/BLAKE3/blob/master/c/blake3_avx2.c
+		// the 8 inputs are hashed side by side, each register holds the same state word of all 8 inputs
+
+		const __m256i rotr16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+		const __m256i rotr8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+
+		// 64-bit block counters, the low words carry into the high words when they wrap around
+		const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000));
+		const __m256i laneOffsets = incrementCounter ? _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) : _mm256_setzero_si256();
+		const __m256i counterLow = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counter)), laneOffsets);
+		const __m256i carry = _mm256_cmpgt_epi32(_mm256_xor_si256(laneOffsets, signBit), _mm256_xor_si256(counterLow, signBit));
+		const __m256i counterHigh = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<int>(counter >> 32)), carry);
+
+		// transpose the 8x8 matrix of 32-bit words in v[o] ~ v[o + 7]
+		#ifdef blake3Avx2Transpose
+		#error "macro name clash"
+		#else
+		#define blake3Avx2Transpose(v, o) \
+		{ \
+			const __m256i ab0145 = _mm256_unpacklo_epi32(v[(o) + 0], v[(o) + 1]); \
+			const __m256i ab2367 = _mm256_unpackhi_epi32(v[(o) + 0], v[(o) + 1]); \
+			const __m256i cd0145 = _mm256_unpacklo_epi32(v[(o) + 2], v[(o) + 3]); \
+			const __m256i cd2367 = _mm256_unpackhi_epi32(v[(o) + 2], v[(o) + 3]); \
+			const __m256i ef0145 = _mm256_unpacklo_epi32(v[(o) + 4], v[(o) + 5]); \
+			const __m256i ef2367 = _mm256_unpackhi_epi32(v[(o) + 4], v[(o) + 5]); \
+			const __m256i gh0145 = _mm256_unpacklo_epi32(v[(o) + 6], v[(o) + 7]); \
+			const __m256i gh2367 = _mm256_unpackhi_epi32(v[(o) + 6], v[(o) + 7]); \
+			const __m256i abcd04 = _mm256_unpacklo_epi64(ab0145, cd0145); \
+			const __m256i abcd15 = _mm256_unpackhi_epi64(ab0145, cd0145); \
+			const __m256i abcd26 = _mm256_unpacklo_epi64(ab2367, cd2367); \
+			const __m256i abcd37 = _mm256_unpackhi_epi64(ab2367, cd2367); \
+			const __m256i efgh04 = _mm256_unpacklo_epi64(ef0145, gh0145); \
+			const __m256i efgh15 = _mm256_unpackhi_epi64(ef0145, gh0145); \
+			const __m256i efgh26 = _mm256_unpacklo_epi64(ef2367, gh2367); \
+			const __m256i efgh37 = _mm256_unpackhi_epi64(ef2367, gh2367); \
+			v[(o) + 0] = _mm256_permute2x128_si256(abcd04, efgh04, 0x20); \
+			v[(o) + 1] = _mm256_permute2x128_si256(abcd15, efgh15, 0x20); \
+			v[(o) + 2] = _mm256_permute2x128_si256(abcd26, efgh26, 0x20); \
+			v[(o) + 3] = _mm256_permute2x128_si256(abcd37, efgh37, 0x20); \
+			v[(o) + 4] = _mm256_permute2x128_si256(abcd04, efgh04, 0x31); \
+			v[(o) + 5] = _mm256_permute2x128_si256(abcd15, efgh15, 0x31); \
+			v[(o) + 6] = _mm256_permute2x128_si256(abcd26, efgh26, 0x31); \
+			v[(o) + 7] = _mm256_permute2x128_si256(abcd37, efgh37, 0x31); \
+		}
+
+		#ifdef blake3Avx2G
+		#error "macro name clash"
+		#else
+		#define blake3Avx2G(a, b, c, d, x, y) \
+			v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), m[x]); \
+			v[d] = _mm256_shuffle_epi8(_mm256_xor_si256(v[d], v[a]), rotr16); \
+			v[c] = _mm256_add_epi32(v[c], v[d]); \
+			v[b] = _mm256_xor_si256(v[b], v[c]); \
+			v[b] = _mm256_or_si256(_mm256_srli_epi32(v[b], 12), _mm256_slli_epi32(v[b], 20)); \
+			v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), m[y]); \
+			v[d] = _mm256_shuffle_epi8(_mm256_xor_si256(v[d], v[a]), rotr8); \
+			v[c] = _mm256_add_epi32(v[c], v[d]); \
+			v[b] = _mm256_xor_si256(v[b], v[c]); \
+			v[b] = _mm256_or_si256(_mm256_srli_epi32(v[b], 7), _mm256_slli_epi32(v[b], 25));
+
+		#ifdef blake3Avx2Round
+		#error "macro name clash"
+		#else
+		#define blake3Avx2Round(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15) \
+			blake3Avx2G(0, 4,  8, 12,  s0,  s1); \
+			blake3Avx2G(1, 5,  9, 13,  s2,  s3); \
+			blake3Avx2G(2, 6, 10, 14,  s4,  s5); \
+			blake3Avx2G(3, 7, 11, 15,  s6,  s7); \
+			blake3Avx2G(0, 5, 10, 15,  s8,  s9); \
+			blake3Avx2G(1, 6, 11, 12, s10, s11); \
+			blake3Avx2G(2, 7,  8, 13, s12, s13); \
+			blake3Avx2G(3, 4,  9, 14, s14, s15);
+
+		__m256i h[8];
+		for (int i = 0; i < 8; ++i)
+			h[i] = _mm256_set1_epi32(static_cast<int>(key[i]));
+
+		uint32_t blockFlags = flags | flagsStart;
+		for (std::size_t block = 0; block < blocks; ++block)
+		{
+			if ((block + 1) == blocks)
+				blockFlags |= flagsEnd;
+
+			__m256i m[16];
+			for (int i = 0; i < 8; ++i)
+			{
+				m[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inputs[i] + (block * 64)));
+				m[i + 8] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inputs[i] + (block * 64) + 32));
+			}
+			blake3Avx2Transpose(m, 0);
+			blake3Avx2Transpose(m, 8);
+
+			__m256i v[16] =
+			{
+				h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+				_mm256_set1_epi32(0x6a09e667), _mm256_set1_epi32(static_cast<int>(0xbb67ae85)),
+				_mm256_set1_epi32(0x3c6ef372), _mm256_set1_epi32(static_cast<int>(0xa54ff53a)),
+				counterLow, counterHigh, _mm256_set1_epi32(64), _mm256_set1_epi32(static_cast<int>(blockFlags))
+			};
+
+			blake3Avx2Round( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15);
+			blake3Avx2Round( 2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8);
+			blake3Avx2Round( 3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1);
+			blake3Avx2Round(10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6);
+			blake3Avx2Round(12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4);
+			blake3Avx2Round( 9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7);
+			blake3Avx2Round(11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13);
+
+			for (int i = 0; i < 8; ++i)
+				h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+
+			blockFlags = flags;
+		}
+
+		blake3Avx2Transpose(h, 0);
+		#undef blake3Avx2Round
+		#endif
+		#undef blake3Avx2G
+		#endif
+		#undef blake3Avx2Transpose
+		#endif
+
+		for (int i = 0; i < 8; ++i)
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + (i * 32)), h[i]);
+	}
+#endif
+#endif
+
+
+namespace Blake3_NS
+{
+	class Blake3
+	{
+		// https://github.com/BLAKE3-team/BLAKE3-specs/blob/master/blake3.pdf
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, 32>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr explicit Blake3(int digestLength = 32);
+			constexpr Blake3(int digestLength, Span<const Byte> key);  // keyed hashing, `key` must be 32 bytes
+			Blake3(int digestLength, const std::string &context);  // key derivation, the input data is the key material
+
+			constexpr void reset();
+			CONSTEXPR_CPP17_CHOCOBO1_HASH Blake3& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;  // `digestLength` bytes of the extendable output
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;  // always the first 32 bytes of the output
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			constexpr Blake3& addData(Span<const Byte> inData);
+			constexpr Blake3& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			constexpr Blake3& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			Blake3& addData(const T (&array)[N]);
+			template <typename T>
+			Blake3& addData(Span<T> inSpan);
+
+			// same as `addData()` but the subtrees of large inputs are hashed on the shared worker threads
+			// `threadCount`: how many tasks the input is split into, `0` means one per thread of the pool
+			Blake3& addDataParallel(Span<const Byte> inData, unsigned int threadCount = 0);
+
+		private:
+			static constexpr int BLOCK_SIZE = 64;
+			static constexpr int CHUNK_SIZE = 1024;
+			static constexpr int OUT_SIZE = 32;
+			static constexpr int MAX_DEPTH = 54;  // 2^54 chunks * 2^10 bytes per chunk = 2^64 bytes
+			static constexpr int MAX_SIMD_DEGREE = 8;  // number of chunks or parents hashed side by side
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller subtrees aren't worth a task
+
+			// domain separation flags
+			static constexpr uint32_t CHUNK_START = 1 << 0;
+			static constexpr uint32_t CHUNK_END = 1 << 1;
+			static constexpr uint32_t PARENT = 1 << 2;
+			static constexpr uint32_t ROOT = 1 << 3;
+			static constexpr uint32_t KEYED_HASH = 1 << 4;
+			static constexpr uint32_t DERIVE_KEY_CONTEXT = 1 << 5;
+			static constexpr uint32_t DERIVE_KEY_MATERIAL = 1 << 6;
+
+			struct Output
+			{
+				// the inputs of a compression that is deferred, so the node can still become the root
+				uint32_t cv[8] = {};
+				uint32_t block[16] = {};
+				uint64_t counter = 0;
+				uint32_t blockLength = 0;
+				uint32_t flags = 0;
+
+				constexpr void chainingValue(Byte *out) const;
+				constexpr void rootBlock(uint64_t outputCounter, uint32_t (&out)[16]) const;
+
+				friend constexpr bool operator==(const Output &left, const Output &right)
+				{
+					for (int i = 0; i < 8; ++i)
+					{
+						if (left.cv[i] != right.cv[i])
+							return false;
+					}
+					for (int i = 0; i < 16; ++i)
+					{
+						if (left.block[i] != right.block[i])
+							return false;
+					}
+					return ((left.counter == right.counter) && (left.blockLength == right.blockLength) && (left.flags == right.flags));
+				}
+			};
+
+			class ChunkState
+			{
+				public:
+					constexpr void reset(const uint32_t (&key)[8], uint64_t counter, uint32_t flags);
+					constexpr std::size_t size() const;
+					constexpr uint64_t counter() const;
+					constexpr void update(const Byte *data, std::size_t length);
+					constexpr Output output() const;
+
+				private:
+					constexpr uint32_t startFlag() const;
+					constexpr void compressBlock(const Byte *block);
+
+					uint32_t m_cv[8] = {};
+					uint64_t m_counter = 0;
+					uint32_t m_flags = 0;
+					int m_blocksCompressed = 0;
+					Buffer<Byte, BLOCK_SIZE> m_buffer;
+			};
+
+		public:
+			friend constexpr bool operator==(const Blake3 &left, const Blake3 &right)
+			{
+				if (left.m_cvStackSize != right.m_cvStackSize)
+					return false;
+				for (int i = 0; i < (left.m_cvStackSize * OUT_SIZE); ++i)
+				{
+					if (left.m_cvStack[i] != right.m_cvStack[i])
+						return false;
+				}
+				return ((left.m_chunk.output() == right.m_chunk.output()) && (left.m_output == right.m_output));
+			}
+			friend constexpr bool operator!=(const Blake3 &left, const Blake3 &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			constexpr Blake3(int digestLength, Span<const Byte> key, uint32_t flags);
+
+			constexpr void addDataImpl(Span<const Byte> data, unsigned int threadCount);
+			constexpr void pushCv(const Byte *cv, uint64_t chunkCounter);
+			constexpr void mergeCvStack(uint64_t totalChunks);
+
+			static constexpr void compress(const uint32_t (&cv)[8], const uint32_t (&block)[16], uint64_t counter, uint32_t blockLength, uint32_t flags, uint32_t (&out)[16]);
+			static constexpr void hashMany(const Byte *const *inputs, std::size_t count, std::size_t blocks, const uint32_t (&key)[8], uint64_t counter
+				, bool incrementCounter, uint32_t flags, uint32_t flagsStart, uint32_t flagsEnd, Byte *out);
+			static constexpr Output parentOutput(const Byte *block, const uint32_t (&key)[8], uint32_t flags);
+
+			static constexpr std::size_t compressChunks(const Byte *input, std::size_t length, const uint32_t (&key)[8], uint64_t chunkCounter, uint32_t flags, Byte *out);
+			static constexpr std::size_t compressParents(const Byte *cvs, std::size_t count, const uint32_t (&key)[8], uint32_t flags, Byte *out);
+			static constexpr std::size_t compressSubtree(const Byte *input, std::size_t length, const uint32_t (&key)[8], uint64_t chunkCounter, uint32_t flags, Byte *out, unsigned int threadCount);
+			static void compressSubtreesParallel(const Byte *input, std::size_t length, std::size_t leftLength, const uint32_t (&key)[8], uint64_t chunkCounter, uint32_t flags, Byte *cvs, unsigned int threadCount, std::size_t (&counts)[2]);
+			static constexpr void compressSubtreeToParent(const Byte *input, std::size_t length, const uint32_t (&key)[8], uint64_t chunkCounter, uint32_t flags, Byte *out, unsigned int threadCount);
+
+			static ResultArrayType deriveKey(const std::string &context);
+
+			int m_digestLength = 0;
+			uint32_t m_key[8] = {};
+			uint32_t m_flags = 0;
+
+			ChunkState m_chunk;
+			Byte m_cvStack[(MAX_DEPTH + 1) * OUT_SIZE] = {};  // chaining values of the completed subtrees, which aren't merged yet
+			int m_cvStackSize = 0;
+
+			Output m_output;
+	};
+
+
+	// helpers
+	template <typename T>
+	class Loader
+	{
+		// this class workaround loading data from unaligned memory boundaries
+		// also eliminate endianness issues
+		public:
+			explicit constexpr Loader(const uint8_t *ptr)
+				: m_ptr(ptr)
+			{
+			}
+
+			constexpr T operator[](const IndexType idx) const
+			{
+				static_assert(std::is_same<T, uint32_t>::value, "");
+				// handle specific endianness here
+				const uint8_t *ptr = m_ptr + (sizeof(T) * idx);
+				return  ( (static_cast<T>(*(ptr + 0)) <<  0)
+						| (static_cast<T>(*(ptr + 1)) <<  8)
+						| (static_cast<T>(*(ptr + 2)) << 16)
+						| (static_cast<T>(*(ptr + 3)) << 24));
+			}
+
+		private:
+			const uint8_t *m_ptr;
+	};
+
+	constexpr void loadBlock(const uint8_t *ptr, uint32_t (&block)[16])
+	{
+		const Loader<uint32_t> m(ptr);
+		for (int i = 0; i < 16; ++i)
+			block[i] = m[i];
+	}
+
+	constexpr void storeWords(const uint32_t *words, const int count, uint8_t *out)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+				*(out++) = ror<uint8_t>(words[i], (j * 8));
+		}
+	}
+
+
+	//
+	constexpr Blake3::Blake3(const int digestLength)
+		: m_digestLength(digestLength)
+		, m_key {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
+	constexpr Blake3::Blake3(const int digestLength, const Span<const Byte> key)
+		: Blake3(digestLength, key, KEYED_HASH)
+	{
+	}
+
+	inline Blake3::Blake3(const int digestLength, const std::string &context)
+		: Blake3(digestLength, deriveKey(context), DERIVE_KEY_MATERIAL)
+	{
+	}
+
+	constexpr Blake3::Blake3(const int digestLength, const Span<const Byte> key, const uint32_t flags)
+		: m_digestLength(digestLength)
+		, m_flags(flags)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		assert(key.size() == OUT_SIZE);
+
+		const Loader<uint32_t> keyView(key.data());
+		for (int i = 0; i < 8; ++i)
+			m_key[i] = keyView[i];
+
+		reset();
+	}
+
+	constexpr void Blake3::reset()
+	{
+		m_chunk.reset(m_key, 0, m_flags);
+		m_cvStackSize = 0;
+		m_output = {};
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake3& Blake3::finalize()
+	{
+		// the right-most path of the tree is merged bottom-up, the last merge is the root node
+		int cvsRemaining = m_cvStackSize;
+		if ((m_chunk.size() > 0) || (m_cvStackSize == 0))
+		{
+			m_output = m_chunk.output();
+		}
+		else
+		{
+			// the input ended on a subtree boundary, there are at least 2 chaining values in the stack
+			cvsRemaining -= 2;
+			m_output = parentOutput((m_cvStack + (cvsRemaining * OUT_SIZE)), m_key, m_flags);
+		}
+
+		while (cvsRemaining > 0)
+		{
+			--cvsRemaining;
+
+			Byte parentBlock[2 * OUT_SIZE] = {};
+			for (int i = 0; i < OUT_SIZE; ++i)
+				parentBlock[i] = m_cvStack[(cvsRemaining * OUT_SIZE) + i];
+			m_output.chainingValue(parentBlock + OUT_SIZE);
+			m_output = parentOutput(parentBlock, m_key, m_flags);
+		}
+
+		return (*this);
+	}
+
+	inline std::string Blake3::toString() const
+	{
+		const auto digest = toVector();
+		std::string ret;
+		ret.resize(2 * digest.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : digest)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
+
+		return ret;
+	}
+
+	inline std::vector<Blake3::Byte> Blake3::toVector() const
+	{
+		// every compression of the root node yields 64 bytes of output
+		std::vector<Byte> ret(static_cast<std::size_t>(m_digestLength));
+		for (std::size_t i = 0; i < ret.size(); i += (2 * OUT_SIZE))
+		{
+			uint32_t words[16] = {};
+			m_output.rootBlock((i / (2 * OUT_SIZE)), words);
+
+			Byte bytes[2 * OUT_SIZE] = {};
+			storeWords(words, 16, bytes);
+			std::copy(bytes, (bytes + std::min<std::size_t>((2 * OUT_SIZE), (ret.size() - i))), (ret.begin() + static_cast<std::ptrdiff_t>(i)));
+		}
+		return ret;
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline Blake3::ResultArrayType Blake3::toArray() const
+	{
+		uint32_t words[16] = {};
+		m_output.rootBlock(0, words);
+
+		ResultArrayType ret {};
+		storeWords(words, 8, ret.data());
+		return ret;
+	}
+
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH Blake3::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	constexpr Blake3& Blake3::addData(const Span<const Byte> inData)
+	{
+		addDataImpl(inData, 1);
+		return (*this);
+	}
+
+	constexpr Blake3& Blake3::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	constexpr Blake3& Blake3::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	Blake3& Blake3::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	Blake3& Blake3::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	inline Blake3& Blake3::addDataParallel(const Span<const Byte> inData, const unsigned int threadCount)
+	{
+		addDataImpl(inData, ((threadCount > 0) ? threadCount : static_cast<unsigned int>(threadPool().workerCount() + 1)));
+		return (*this);
+	}
+
+	constexpr void Blake3::addDataImpl(const Span<const Byte> data, const unsigned int threadCount)
+	{
+		const Byte *ptr = data.data();
+		std::size_t length = static_cast<std::size_t>(data.size());
+
+		// finish the partial chunk first
+		if (m_chunk.size() > 0)
+		{
+			const std::size_t len = std::min<std::size_t>((CHUNK_SIZE - m_chunk.size()), length);
+			m_chunk.update(ptr, len);
+			ptr += len;
+			length -= len;
+			if (length == 0)
+				return;
+
+			// more data follows, so the chunk isn't the root
+			Byte cv[OUT_SIZE] = {};
+			m_chunk.output().chainingValue(cv);
+			pushCv(cv, m_chunk.counter());
+			m_chunk.reset(m_key, (m_chunk.counter() + 1), m_flags);
+		}
+
+		// hash whole subtrees, each one is the largest power-of-2 number of chunks aligned to the chunks hashed so far
+		uint64_t chunkCounter = m_chunk.counter();
+		while (length > CHUNK_SIZE)
+		{
+			std::size_t subtreeLength = 1;
+			while ((subtreeLength * 2) <= length)
+				subtreeLength *= 2;
+			while (((static_cast<uint64_t>(subtreeLength) - 1) & (chunkCounter * CHUNK_SIZE)) != 0)
+				subtreeLength /= 2;
+			const uint64_t subtreeChunks = subtreeLength / CHUNK_SIZE;
+
+			if (subtreeLength <= CHUNK_SIZE)
+			{
+				ChunkState chunk;
+				chunk.reset(m_key, chunkCounter, m_flags);
+				chunk.update(ptr, subtreeLength);
+
+				Byte cv[OUT_SIZE] = {};
+				chunk.output().chainingValue(cv);
+				pushCv(cv, chunkCounter);
+			}
+			else
+			{
+				Byte cvPair[2 * OUT_SIZE] = {};
+				compressSubtreeToParent(ptr, subtreeLength, m_key, chunkCounter, m_flags, cvPair, threadCount);
+				pushCv(cvPair, chunkCounter);
+				pushCv((cvPair + OUT_SIZE), (chunkCounter + (subtreeChunks / 2)));
+			}
+
+			chunkCounter += subtreeChunks;
+			ptr += subtreeLength;
+			length -= subtreeLength;
+		}
+		m_chunk.reset(m_key, chunkCounter, m_flags);
+
+		if (length > 0)
+		{
+			m_chunk.update(ptr, length);
+			mergeCvStack(chunkCounter);
+		}
+	}
+
+	constexpr void Blake3::pushCv(const Byte *cv, const uint64_t chunkCounter)
+	{
+		mergeCvStack(chunkCounter);
+
+		for (int i = 0; i < OUT_SIZE; ++i)
+			m_cvStack[(m_cvStackSize * OUT_SIZE) + i] = cv[i];
+		++m_cvStackSize;
+	}
+
+	constexpr void Blake3::mergeCvStack(const uint64_t totalChunks)
+	{
+		// after merging, there is one chaining value per set bit in `totalChunks`
+		// the merge is lazy: the newest subtree is only merged when more data follows, since it might be the root node
+		int postMergeSize = 0;
+		for (uint64_t i = totalChunks; i > 0; i &= (i - 1))
+			++postMergeSize;
+
+		while (m_cvStackSize > postMergeSize)
+		{
+			Byte *parentBlock = m_cvStack + ((m_cvStackSize - 2) * OUT_SIZE);
+			parentOutput(parentBlock, m_key, m_flags).chainingValue(parentBlock);
+			--m_cvStackSize;
+		}
+	}
+
+	constexpr void Blake3::compress(const uint32_t (&cv)[8], const uint32_t (&block)[16], const uint64_t counter, const uint32_t blockLength, const uint32_t flags, uint32_t (&out)[16])
+	{
+		const uint32_t (&m)[16] = block;
+
+		uint32_t v[16] =
+		{
+			cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+			0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+			ror<uint32_t>(counter, 0), ror<uint32_t>(counter, 32), blockLength, flags
+		};
+
+		#ifdef blakeMix
+		#error "macro name clash"
+		#else
+		#define blakeMix(a, b, c, d, x, y) \
+			a = (a + b + x); \
+			d = rotr((d ^ a), 16); \
+			c = (c + d); \
+			b = rotr((b ^ c), 12); \
+			a = (a + b + y); \
+			d = rotr((d ^ a), 8); \
+			c = (c + d); \
+			b = rotr((b ^ c), 7);
+
+		// the message words are permuted between rounds, these are the accumulated permutations
+		#ifdef blake3Round
+		#error "macro name clash"
+		#else
+		#define blake3Round(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15) \
+			blakeMix(v[0], v[4], v[8], v[12], m[s0], m[s1]); \
+			blakeMix(v[1], v[5], v[9], v[13], m[s2], m[s3]); \
+			blakeMix(v[2], v[6], v[10], v[14], m[s4], m[s5]); \
+			blakeMix(v[3], v[7], v[11], v[15], m[s6], m[s7]); \
+			blakeMix(v[0], v[5], v[10], v[15], m[s8], m[s9]); \
+			blakeMix(v[1], v[6], v[11], v[12], m[s10], m[s11]); \
+			blakeMix(v[2], v[7], v[8], v[13], m[s12], m[s13]); \
+			blakeMix(v[3], v[4], v[9], v[14], m[s14], m[s15]);
+
+		blake3Round( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15);
+		blake3Round( 2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8);
+		blake3Round( 3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1);
+		blake3Round(10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6);
+		blake3Round(12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4);
+		blake3Round( 9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7);
+		blake3Round(11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13);
+		#undef blake3Round
+		#endif
+		#undef blakeMix
+		#endif
+
+		for (int i = 0; i < 8; ++i)
+		{
+			out[i] = v[i] ^ v[i + 8];
+			out[i + 8] = v[i + 8] ^ cv[i];
+		}
+	}
+
+	constexpr void Blake3::hashMany(const Byte *const *inputs, std::size_t count, const std::size_t blocks, const uint32_t (&key)[8], uint64_t counter
+		, const bool incrementCounter, const uint32_t flags, const uint32_t flagsStart, const uint32_t flagsEnd, Byte *out)
+	{
+		// hash `count` inputs of `blocks` blocks each, every input produces a chaining value in `out`
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (!isConstantEvaluated() && cpuFeatures().avx2)
+		{
+			for (; count >= 8; count -= 8)
+			{
+				blake3HashEightAvx2(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+				if (incrementCounter)
+					counter += 8;
+				inputs += 8;
+				out += (8 * OUT_SIZE);
+			}
+		}
+#endif
+
+		for (; count > 0; --count)
+		{
+			uint32_t cv[8] = {};
+			for (int i = 0; i < 8; ++i)
+				cv[i] = key[i];
+
+			uint32_t blockFlags = flags | flagsStart;
+			for (std::size_t i = 0; i < blocks; ++i)
+			{
+				if ((i + 1) == blocks)
+					blockFlags |= flagsEnd;
+
+				uint32_t block[16] = {};
+				loadBlock((*inputs + (i * BLOCK_SIZE)), block);
+				uint32_t words[16] = {};
+				compress(cv, block, counter, BLOCK_SIZE, blockFlags, words);
+				for (int j = 0; j < 8; ++j)
+					cv[j] = words[j];
+
+				blockFlags = flags;
+			}
+			storeWords(cv, 8, out);
+
+			if (incrementCounter)
+				++counter;
+			++inputs;
+			out += OUT_SIZE;
+		}
+	}
+
+	constexpr Blake3::Output Blake3::parentOutput(const Byte *block, const uint32_t (&key)[8], const uint32_t flags)
+	{
+		Output ret;
+		for (int i = 0; i < 8; ++i)
+			ret.cv[i] = key[i];
+		loadBlock(block, ret.block);
+		ret.counter = 0;
+		ret.blockLength = BLOCK_SIZE;
+		ret.flags = flags | PARENT;
+		return ret;
+	}
+
+	constexpr std::size_t Blake3::compressChunks(const Byte *input, const std::size_t length, const uint32_t (&key)[8], const uint64_t chunkCounter, const uint32_t flags, Byte *out)
+	{
+		// hash up to `MAX_SIMD_DEGREE` chunks side by side, returns the number of chaining values written to `out`
+		assert(length <= (MAX_SIMD_DEGREE * CHUNK_SIZE));
+
+		const Byte *chunks[MAX_SIMD_DEGREE] = {};
+		std::size_t count = 0;
+		for (; ((count + 1) * CHUNK_SIZE) <= length; ++count)
+			chunks[count] = input + (count * CHUNK_SIZE);
+		hashMany(chunks, count, (CHUNK_SIZE / BLOCK_SIZE), key, chunkCounter, true, flags, CHUNK_START, CHUNK_END, out);
+
+		// the last chunk might be a partial one
+		if (length > (count * CHUNK_SIZE))
+		{
+			ChunkState chunk;
+			chunk.reset(key, (chunkCounter + count), flags);
+			chunk.update((input + (count * CHUNK_SIZE)), (length - (count * CHUNK_SIZE)));
+			chunk.output().chainingValue(out + (count * OUT_SIZE));
+			++count;
+		}
+
+		return count;
+	}
+
+	constexpr std::size_t Blake3::compressParents(const Byte *cvs, const std::size_t count, const uint32_t (&key)[8], const uint32_t flags, Byte *out)
+	{
+		// merge pairs of chaining values, an odd one out is passed through to the next level
+		assert(count <= (2 * MAX_SIMD_DEGREE));
+
+		const Byte *parents[MAX_SIMD_DEGREE] = {};
+		std::size_t parentCount = 0;
+		for (; ((parentCount + 1) * 2) <= count; ++parentCount)
+			parents[parentCount] = cvs + (parentCount * 2 * OUT_SIZE);
+		hashMany(parents, parentCount, 1, key, 0, false, (flags | PARENT), 0, 0, out);
+
+		if (count > (parentCount * 2))
+		{
+			for (int i = 0; i < OUT_SIZE; ++i)
+				out[(parentCount * OUT_SIZE) + i] = cvs[(parentCount * 2 * OUT_SIZE) + i];
+			++parentCount;
+		}
+
+		return parentCount;
+	}
+
+	constexpr std::size_t Blake3::compressSubtree(const Byte *input, const std::size_t length, const uint32_t (&key)[8], const uint64_t chunkCounter, const uint32_t flags, Byte *out, const unsigned int threadCount)
+	{
+		// hash a subtree down to at most `MAX_SIMD_DEGREE` chaining values, instead of 1, so that
+		// the parent nodes of each level can also be hashed side by side. Returns the number of chaining values.
+
+		if (length <= (MAX_SIMD_DEGREE * CHUNK_SIZE))
+			return compressChunks(input, length, key, chunkCounter, flags, out);
+
+		// the left subtree takes the largest power-of-2 number of chunks that leaves some data for the right subtree
+		std::size_t leftLength = CHUNK_SIZE;
+		while ((leftLength * 2) < length)
+			leftLength *= 2;
+
+		// the left subtree is full, it always returns `MAX_SIMD_DEGREE` chaining values
+		Byte cvs[2 * MAX_SIMD_DEGREE * OUT_SIZE] = {};
+		std::size_t counts[2] = {};
+		if ((threadCount > 1) && (length >= MIN_PARALLEL_SIZE))
+		{
+			compressSubtreesParallel(input, length, leftLength, key, chunkCounter, flags, cvs, threadCount, counts);
+		}
+		else
+		{
+			counts[0] = compressSubtree(input, leftLength, key, chunkCounter, flags, cvs, 1);
+			counts[1] = compressSubtree((input + leftLength), (length - leftLength), key, (chunkCounter + (leftLength / CHUNK_SIZE)), flags, (cvs + (MAX_SIMD_DEGREE * OUT_SIZE)), 1);
+		}
+
+		return compressParents(cvs, (counts[0] + counts[1]), key, flags, out);
+	}
+
+	inline void Blake3::compressSubtreesParallel(const Byte *input, const std::size_t length, const std::size_t leftLength, const uint32_t (&key)[8], const uint64_t chunkCounter, const uint32_t flags
+		, Byte *cvs, const unsigned int threadCount, std::size_t (&counts)[2])
+	{
+		// the 2 subtrees are tasks of the thread pool, `threadCount` is split between them
+		threadPool().parallelFor(2, [=, &key, &counts](const std::size_t idx) -> void
+		{
+			if (idx == 0)
+				counts[0] = compressSubtree(input, leftLength, key, chunkCounter, flags, cvs, (threadCount / 2));
+			else
+				counts[1] = compressSubtree((input + leftLength), (length - leftLength), key, (chunkCounter + (leftLength / CHUNK_SIZE)), flags, (cvs + (MAX_SIMD_DEGREE * OUT_SIZE)), (threadCount - (threadCount / 2)));
+		});
+	}
+
+	constexpr void Blake3::compressSubtreeToParent(const Byte *input, const std::size_t length, const uint32_t (&key)[8], const uint64_t chunkCounter, const uint32_t flags, Byte *out, const unsigned int threadCount)
+	{
+		// hash a subtree of more than 1 chunk down to the 2 chaining values of its root node
+		Byte cvs[MAX_SIMD_DEGREE * OUT_SIZE] = {};
+		std::size_t count = compressSubtree(input, length, key, chunkCounter, flags, cvs, threadCount);
+		while (count > 2)
+		{
+			Byte parents[(MAX_SIMD_DEGREE / 2) * OUT_SIZE] = {};
+			count = compressParents(cvs, count, key, flags, parents);
+			for (std::size_t i = 0; i < (count * OUT_SIZE); ++i)
+				cvs[i] = parents[i];
+		}
+
+		for (int i = 0; i < (2 * OUT_SIZE); ++i)
+			out[i] = cvs[i];
+	}
+
+	inline Blake3::ResultArrayType Blake3::deriveKey(const std::string &context)
+	{
+		// the context string is hashed with the default key, the digest is the key of the derivation
+		Blake3 hash(OUT_SIZE);
+		hash.m_flags = DERIVE_KEY_CONTEXT;
+		hash.reset();
+		return hash.addData(context.data(), context.size()).finalize().toArray();
+	}
+
+	constexpr void Blake3::Output::chainingValue(Byte *out) const
+	{
+		uint32_t words[16] = {};
+		compress(cv, block, counter, blockLength, flags, words);
+		storeWords(words, 8, out);
+	}
+
+	constexpr void Blake3::Output::rootBlock(const uint64_t outputCounter, uint32_t (&out)[16]) const
+	{
+		compress(cv, block, outputCounter, blockLength, (flags | ROOT), out);
+	}
+
+	constexpr void Blake3::ChunkState::reset(const uint32_t (&key)[8], const uint64_t counter, const uint32_t flags)
+	{
+		for (int i = 0; i < 8; ++i)
+			m_cv[i] = key[i];
+		m_counter = counter;
+		m_flags = flags;
+		m_blocksCompressed = 0;
+		m_buffer.clear();
+	}
+
+	constexpr std::size_t Blake3::ChunkState::size() const
+	{
+		return ((static_cast<std::size_t>(m_blocksCompressed) * BLOCK_SIZE) + m_buffer.size());
+	}
+
+	constexpr uint64_t Blake3::ChunkState::counter() const
+	{
+		return m_counter;
+	}
+
+	constexpr void Blake3::ChunkState::update(const Byte *data, std::size_t length)
+	{
+		assert((size() + length) <= CHUNK_SIZE);
+
+		while (length > 0)
+		{
+			if (m_buffer.size() == BLOCK_SIZE)
+			{
+				compressBlock(m_buffer.data());
+				m_buffer.clear();
+			}
+
+			// the last block is always kept in the buffer, it is compressed by `output()`
+			if (m_buffer.empty())
+			{
+				for (; length > BLOCK_SIZE; length -= BLOCK_SIZE)
+				{
+					compressBlock(data);
+					data += BLOCK_SIZE;
+				}
+			}
+
+			const std::size_t len = std::min<std::size_t>((BLOCK_SIZE - m_buffer.size()), length);
+			m_buffer.push_back(data, (data + len));
+			data += len;
+			length -= len;
+		}
+	}
+
+	constexpr Blake3::Output Blake3::ChunkState::output() const
+	{
+		Output ret;
+		for (int i = 0; i < 8; ++i)
+			ret.cv[i] = m_cv[i];
+		loadBlock(m_buffer.data(), ret.block);  // the unused bytes of the buffer are zeros
+		ret.counter = m_counter;
+		ret.blockLength = static_cast<uint32_t>(m_buffer.size());
+		ret.flags = m_flags | startFlag() | CHUNK_END;
+		return ret;
+	}
+
+	constexpr uint32_t Blake3::ChunkState::startFlag() const
+	{
+		return ((m_blocksCompressed == 0) ? CHUNK_START : 0);
+	}
+
+	constexpr void Blake3::ChunkState::compressBlock(const Byte *block)
+	{
+		uint32_t words[16] = {};
+		loadBlock(block, words);
+
+		uint32_t out[16] = {};
+		compress(m_cv, words, m_counter, BLOCK_SIZE, (m_flags | startFlag()), out);
+		for (int i = 0; i < 8; ++i)
+			m_cv[i] = out[i];
+		++m_blocksCompressed;
+	}
+}
+}
+
+	using Blake3 = Hash::Blake3_NS::Blake3;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::Blake3>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Blake3 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_BLAKE3_H
@@ -0,0 +1,546 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_CRC_H
+#define CHOCOBO1_CRC_H
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// CRC_16();
+	// CRC_32_BZIP2();
+	// CRC_64_XZ();
+	// or define your own: `Hash::CRC_NS::CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>`
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+#ifndef CONSTEXPR_CPP17_CHOCOBO1_HASH
+#if __cplusplus >= 201703L
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH constexpr
+#else
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH
+#endif
+#endif
+
+#ifndef INLINE_CLASS_VARIABLE_CHOCOBO1_HASH
+#if __cplusplus >= 201703L
+#define INLINE_CLASS_VARIABLE_CHOCOBO1_HASH constexpr static
+#define HAS_INLINE_CLASS_VARIABLE_CHOCOBO1_HASH
+#else
+#define INLINE_CLASS_VARIABLE_CHOCOBO1_HASH const
+#endif
+#endif
+
+#ifndef CHOCOBO1_HASH_ROR_IMPL
+#define CHOCOBO1_HASH_ROR_IMPL
+	template <typename R, typename T>
+	constexpr R ror(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<R>::value, "");
+		static_assert(std::is_unsigned<T>::value, "");
+		return static_cast<R>(x >> s);
+	}
+#endif
+
+namespace CRC_NS
+{
+	template <int Width>
+	using RegisterType = typename std::conditional<(Width <= 8), uint8_t,
+		typename std::conditional<(Width <= 16), uint16_t,
+		typename std::conditional<(Width <= 32), uint32_t, uint64_t>::type>::type>::type;
+
+	template <typename T>
+	constexpr T reflect(const T value, const int width)
+	{
+		T ret = 0;
+		for (int i = 0; i < width; ++i)
+			ret = static_cast<T>(ret | (((value >> i) & 1) << (width - 1 - i)));
+		return ret;
+	}
+
+	template <typename T, int Slices>
+	struct SlicerTable
+	{
+		T data[Slices][256];
+	};
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr SlicerTable<RegisterType<Width>, Slices> generateSlicerTable()
+	{
+		using T = RegisterType<Width>;
+
+		const T mask = static_cast<T>(~static_cast<uint64_t>(0) >> (64 - Width));
+		const T topBit = static_cast<T>(static_cast<T>(1) << (Width - 1));
+		const T poly = Reflected ? reflect(static_cast<T>(Poly), Width) : static_cast<T>(Poly);
+
+		SlicerTable<T, Slices> ret {};
+		for (int i = 0; i < 256; ++i)
+		{
+			T crc = Reflected ? static_cast<T>(i) : static_cast<T>(static_cast<uint64_t>(i) << (Width - 8));
+			for (int j = 0; j < 8; ++j)
+			{
+				if (Reflected)
+					crc = static_cast<T>((crc >> 1) ^ ((crc & 1) * poly));
+				else
+					crc = static_cast<T>((static_cast<T>(crc << 1) ^ (((crc & topBit) != 0) ? poly : 0)) & mask);
+			}
+			ret.data[0][i] = crc;
+		}
+		for (int slice = 1; slice < Slices; ++slice)
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				const T prev = ret.data[slice - 1][i];
+				if (Reflected)
+					ret.data[slice][i] = static_cast<T>((static_cast<uint64_t>(prev) >> 8) ^ ret.data[0][prev & 0xFF]);
+				else
+					ret.data[slice][i] = static_cast<T>(((static_cast<uint64_t>(prev) << 8) & mask) ^ ret.data[0][(prev >> (Width - 8)) & 0xFF]);
+			}
+		}
+		return ret;
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	class Slicer
+	{
+		// table driven CRC register update with tables generated at compile time
+		// not my algorithm, "Slicing-by-N" from: http://create.stephan-brumme.com/crc32/
+
+		static_assert(((Width >= 8) && (Width <= 64) && ((Width % 8) == 0)), "Width must be a multiple of 8, up to 64");
+		static_assert(((Slices == 1) || (Slices == 4) || (Slices == 8) || (Slices == 16)), "Slices must be 1, 4, 8 or 16");
+
+		public:
+			using Byte = uint8_t;
+			using Register = RegisterType<Width>;
+
+			// `crc` is the raw register value, in reflected bit order when `Reflected` is true
+			static constexpr Register update(Register crc, const Byte *data, std::size_t length);
+
+		private:
+			static constexpr int BYTES = Width / 8;
+
+			template <int Idx>
+			static constexpr Register foldWords(Register crc, const Byte *ptr, std::integral_constant<int, Idx>);
+			static constexpr Register foldWords(Register crc, const Byte *ptr, std::integral_constant<int, Slices>);
+			static constexpr uint32_t loadWord(const Byte *ptr);
+			static constexpr uint32_t registerWord(Register crc, int idx);
+			static constexpr Byte wordByte(uint32_t word, int idx);
+			static constexpr Register shiftOut(Register crc, int bytes);
+
+			static constexpr SlicerTable<Register, Slices> table = generateSlicerTable<Width, Poly, Reflected, Slices>();
+	};
+
+#ifndef HAS_INLINE_CLASS_VARIABLE_CHOCOBO1_HASH
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr SlicerTable<RegisterType<Width>, Slices> Slicer<Width, Poly, Reflected, Slices>::table;
+#endif
+
+	template <int Width, uint64_t Poly>
+	constexpr RegisterType<Width> multiplyModP(const RegisterType<Width> a, const RegisterType<Width> b)
+	{
+		// carry-less multiplication modulo P, polynomials are in reflected bit order: x^0 is the most significant bit
+		using T = RegisterType<Width>;
+
+		const T poly = reflect(static_cast<T>(Poly), Width);
+
+		T ret = 0;
+		T bShifted = b;
+		for (T mask = static_cast<T>(static_cast<T>(1) << (Width - 1)); mask != 0; mask = static_cast<T>(mask >> 1))
+		{
+			if ((a & mask) != 0)
+				ret = static_cast<T>(ret ^ bShifted);
+			bShifted = static_cast<T>((bShifted >> 1) ^ ((bShifted & 1) * poly));
+		}
+		return ret;
+	}
+
+	template <int Width, uint64_t Poly>
+	constexpr RegisterType<Width> shiftZeroBytes(const RegisterType<Width> value, const uint64_t length)
+	{
+		// `value * x^(8 * length) mod P`: a reflected register after `length` zero bytes, in O(log(length)) steps
+		using T = RegisterType<Width>;
+
+		const T poly = reflect(static_cast<T>(Poly), Width);
+		const T one = static_cast<T>(static_cast<T>(1) << (Width - 1));
+
+		T square = one;  // x^(8 * 2^i) mod P
+		for (int i = 0; i < 8; ++i)
+			square = static_cast<T>((square >> 1) ^ ((square & 1) * poly));
+
+		T xPow = one;  // x^(8 * length) mod P
+		for (uint64_t n = length; n > 0; n >>= 1)
+		{
+			if ((n & 1) != 0)
+				xPow = multiplyModP<Width, Poly>(xPow, square);
+			square = multiplyModP<Width, Poly>(square, square);
+		}
+		return multiplyModP<Width, Poly>(xPow, value);
+	}
+
+	template <typename Crc, typename Register, typename Span>
+	Register addDataParallel(const Register crc, const Span data, const unsigned int pieces)
+	{
+		// continues the finalized `crc` with `data`: the pieces of `data` are hashed on the shared worker threads then combined
+		// `pieces == 0` means one piece per thread of the pool
+		const std::size_t MIN_PIECE_SIZE = 1024 * 1024;  // smaller pieces aren't worth a task
+
+		const std::size_t dataSize = static_cast<std::size_t>(data.size());
+		std::size_t count = (pieces > 0) ? pieces : (threadPool().workerCount() + 1);
+		count = std::max<std::size_t>(std::min(count, (dataSize / MIN_PIECE_SIZE)), 1);
+		const std::size_t pieceSize = (dataSize + count - 1) / count;
+
+		std::vector<Register> crcs(count);
+		threadPool().parallelFor(count, [&data, &crcs, pieceSize, dataSize](const std::size_t idx) -> void
+		{
+			const std::size_t begin = idx * pieceSize;
+			crcs[idx] = Crc().addData(data.subspan(begin, std::min(pieceSize, (dataSize - begin)))).finalize();
+		});
+
+		Register ret = crc;
+		for (std::size_t i = 0; i < count; ++i)
+			ret = Crc::combine(ret, crcs[i], std::min(pieceSize, (dataSize - (i * pieceSize))));
+		return ret;
+	}
+
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices = 16>
+	class CRC
+	{
+		// parameters follow the "Rocksoft^tm Model CRC Algorithm": https://reveng.sourceforge.io/crc-catalogue/
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, (Width / 8)>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr CRC();
+
+			constexpr void reset();
+			constexpr CRC& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			constexpr CRC& addData(Span<const Byte> inData);
+			constexpr CRC& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			constexpr CRC& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			CRC& addData(const T (&array)[N]);
+			template <typename T>
+			CRC& addData(Span<T> inSpan);
+
+			// returns the CRC of `A || B` from the CRC of `A` and the CRC & length of `B`, CRCs are the finalized values
+			static constexpr RegisterType<Width> combine(RegisterType<Width> crcA, RegisterType<Width> crcB, uint64_t lengthB);
+
+			friend constexpr bool operator==(const CRC &left, const CRC &right)
+			{
+				return (left.m_h == right.m_h);
+			}
+			friend constexpr bool operator!=(const CRC &left, const CRC &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			using SlicerType = Slicer<Width, Poly, RefIn, Slices>;
+
+			typename SlicerType::Register m_h = 0;
+	};
+
+
+	//
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr typename Slicer<Width, Poly, Reflected, Slices>::Register Slicer<Width, Poly, Reflected, Slices>::update(const Register crc, const Byte *data, const std::size_t length)
+	{
+		Register h = crc;
+
+		std::size_t processed = 0;
+		if (Slices >= 4)
+		{
+			for (; (processed + Slices) <= length; processed += Slices)
+			{
+				h = static_cast<Register>(shiftOut(h, Slices) ^ foldWords(h, (data + processed), std::integral_constant<int, ((Slices >= 4) ? 0 : Slices)>()));
+			}
+		}
+
+		// remaining bytes use "standard algorithm"
+		for (; processed < length; ++processed)
+			h = static_cast<Register>(shiftOut(h, 1) ^ table.data[0][static_cast<Byte>(data[processed] ^ wordByte(registerWord(h, 0), 0))]);
+
+		return h;
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	template <int Idx>
+	constexpr typename Slicer<Width, Poly, Reflected, Slices>::Register Slicer<Width, Poly, Reflected, Slices>::foldWords(const Register crc, const Byte *ptr, std::integral_constant<int, Idx>)
+	{
+		// a recursion instead of a loop, so that compilers always unroll it
+		const uint32_t m = loadWord(ptr + Idx) ^ registerWord(crc, Idx);
+		return static_cast<Register>(table.data[Slices - 1 - Idx][wordByte(m, 0)]
+			^ table.data[Slices - 2 - Idx][wordByte(m, 1)]
+			^ table.data[Slices - 3 - Idx][wordByte(m, 2)]
+			^ table.data[Slices - 4 - Idx][wordByte(m, 3)]
+			^ foldWords(crc, ptr, std::integral_constant<int, (Idx + 4)>()));
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr typename Slicer<Width, Poly, Reflected, Slices>::Register Slicer<Width, Poly, Reflected, Slices>::foldWords(const Register, const Byte *, std::integral_constant<int, Slices>)
+	{
+		return 0;
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr uint32_t Slicer<Width, Poly, Reflected, Slices>::loadWord(const Byte *ptr)
+	{
+		// data bytes in processing order, see `wordByte()`
+		return Reflected
+			? ((static_cast<uint32_t>(ptr[0]) <<  0)
+				| (static_cast<uint32_t>(ptr[1]) <<  8)
+				| (static_cast<uint32_t>(ptr[2]) << 16)
+				| (static_cast<uint32_t>(ptr[3]) << 24))
+			: ((static_cast<uint32_t>(ptr[0]) << 24)
+				| (static_cast<uint32_t>(ptr[1]) << 16)
+				| (static_cast<uint32_t>(ptr[2]) <<  8)
+				| (static_cast<uint32_t>(ptr[3]) <<  0));
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr uint32_t Slicer<Width, Poly, Reflected, Slices>::registerWord(const Register crc, const int idx)
+	{
+		// the register bytes that line up with the upcoming data bytes `idx` to `idx + 3`, laid out like `loadWord()`
+		if (idx >= BYTES)
+			return 0;
+		if (Reflected)
+			return static_cast<uint32_t>(static_cast<uint64_t>(crc) >> (idx * 8));
+
+		const int shift = Width - 32 - (idx * 8);
+		return (shift >= 0)
+			? static_cast<uint32_t>(static_cast<uint64_t>(crc) >> shift)
+			: static_cast<uint32_t>(static_cast<uint64_t>(crc) << -shift);
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr typename Slicer<Width, Poly, Reflected, Slices>::Byte Slicer<Width, Poly, Reflected, Slices>::wordByte(const uint32_t word, const int idx)
+	{
+		return Reflected
+			? ror<Byte>(word, static_cast<unsigned int>(idx * 8))
+			: ror<Byte>(word, static_cast<unsigned int>(24 - (idx * 8)));
+	}
+
+	template <int Width, uint64_t Poly, bool Reflected, int Slices>
+	constexpr typename Slicer<Width, Poly, Reflected, Slices>::Register Slicer<Width, Poly, Reflected, Slices>::shiftOut(const Register crc, const int bytes)
+	{
+		// the register after `bytes` bytes are shifted out
+		const uint64_t mask = ~static_cast<uint64_t>(0) >> (64 - Width);
+		if (bytes >= BYTES)
+			return 0;
+		return Reflected
+			? static_cast<Register>(static_cast<uint64_t>(crc) >> (bytes * 8))
+			: static_cast<Register>((static_cast<uint64_t>(crc) << (bytes * 8)) & mask);
+	}
+
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::CRC()
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr void CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::reset()
+	{
+		using Register = typename SlicerType::Register;
+		m_h = RefIn ? reflect(static_cast<Register>(Init), Width) : static_cast<Register>(Init);
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::finalize()
+	{
+		using Register = typename SlicerType::Register;
+		if (RefIn != RefOut)
+			m_h = reflect(m_h, Width);
+		m_h = static_cast<Register>(m_h ^ static_cast<Register>(XorOut));
+		return (*this);
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	std::string CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::toString() const
+	{
+		const auto digest = toArray();
+		std::string ret;
+		ret.resize(2 * digest.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : digest)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
+
+		return ret;
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	std::vector<typename CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::Byte> CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::toVector() const
+	{
+		const auto digest = toArray();
+		return {digest.begin(), digest.end()};
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::ResultArrayType CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::toArray() const
+	{
+		ResultArrayType ret {};
+		auto *retPtr = ret.data();
+		for (int j = (static_cast<int>(ret.size()) - 1); j >= 0; --j)
+			*(retPtr++) = ror<Byte>(m_h, static_cast<unsigned int>(j * 8));
+
+		return ret;
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret = static_cast<T>(ret << 8);
+			ret = static_cast<T>(ret | digest[i]);
+		}
+		return ret;
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::addData(const Span<const Byte> inData)
+	{
+		m_h = SlicerType::update(m_h, inData.data(), static_cast<std::size_t>(inData.size()));
+		return (*this);
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	template <std::size_t N>
+	constexpr CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	template <typename T, std::size_t N>
+	CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	template <typename T>
+	CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>& CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	constexpr RegisterType<Width> CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>::combine(const RegisterType<Width> crcA, const RegisterType<Width> crcB, const uint64_t lengthB)
+	{
+		// the registers are affine in the data: reg(A || B) = ((reg(A) ^ reg(empty)) * x^(8 * lengthB) mod P) ^ reg(B)
+		// undoing `finalize()` gives the registers in reflected bit order when `RefOut` is true, `reflect()` them otherwise
+		using T = RegisterType<Width>;
+
+		const T xorOut = static_cast<T>(XorOut);
+		const T init = reflect(static_cast<T>(Init), Width);
+		const T regA = RefOut ? static_cast<T>(crcA ^ xorOut) : reflect(static_cast<T>(crcA ^ xorOut), Width);
+		const T regB = RefOut ? static_cast<T>(crcB ^ xorOut) : reflect(static_cast<T>(crcB ^ xorOut), Width);
+
+		const T regAB = static_cast<T>(shiftZeroBytes<Width, Poly>(static_cast<T>(regA ^ init), lengthB) ^ regB);
+		return static_cast<T>((RefOut ? regAB : reflect(regAB, Width)) ^ xorOut);
+	}
+}
+}
+
+	using CRC_16 = Hash::CRC_NS::CRC<16, 0x8005, 0x0000, true, true, 0x0000>;  // CRC-16/ARC
+	using CRC_32_BZIP2 = Hash::CRC_NS::CRC<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF>;
+	using CRC_64_XZ = Hash::CRC_NS::CRC<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF>;
+}
+
+namespace std
+{
+	template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut, int Slices>
+	struct hash<Chocobo1::Hash::CRC_NS::CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices>>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Hash::CRC_NS::CRC<Width, Poly, Init, RefIn, RefOut, XorOut, Slices> &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_CRC_H
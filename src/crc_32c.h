@@ -0,0 +1,377 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2020 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_CRC_32C_H
+#define CHOCOBO1_CRC_32C_H
+
+#include "crc.h"
+#include "x86_simd.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// CRC_32C();
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+#ifndef CONSTEXPR_CPP17_CHOCOBO1_HASH
+#if __cplusplus >= 201703L
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH constexpr
+#else
+#define CONSTEXPR_CPP17_CHOCOBO1_HASH
+#endif
+#endif
+
+#ifndef INLINE_CLASS_VARIABLE_CHOCOBO1_HASH
+#if __cplusplus >= 201703L
+#define INLINE_CLASS_VARIABLE_CHOCOBO1_HASH constexpr static
+#define HAS_INLINE_CLASS_VARIABLE_CHOCOBO1_HASH
+#else
+#define INLINE_CLASS_VARIABLE_CHOCOBO1_HASH const
+#endif
+#endif
+
+#ifndef CHOCOBO1_HASH_ROR_IMPL
+#define CHOCOBO1_HASH_ROR_IMPL
+	template <typename R, typename T>
+	constexpr R ror(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<R>::value, "");
+		static_assert(std::is_unsigned<T>::value, "");
+		return static_cast<R>(x >> s);
+	}
+#endif
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_CRC32C_SSE42_IMPL
+#define CHOCOBO1_HASH_CRC32C_SSE42_IMPL
+#if (defined(__x86_64__) || defined(_M_X64))
+	using Crc32cWordType = uint64_t;
+#define crc32cWord(crc, ptr) _mm_crc32_u64(crc, crc32cLoad(ptr))
+#else
+	using Crc32cWordType = uint32_t;
+#define crc32cWord(crc, ptr) _mm_crc32_u32(crc, crc32cLoad(ptr))
+#endif
+
+	inline Crc32cWordType crc32cLoad(const uint8_t *ptr)
+	{
+		Crc32cWordType ret = 0;
+		std::memcpy(&ret, ptr, sizeof(ret));
+		return ret;
+	}
+
+	X86_TARGET_CHOCOBO1_HASH("sse4.2,pclmul")
+	inline uint32_t crc32cShift(const uint32_t crc, const uint32_t k)
+	{
+		// returns `crc * x^(8 * n) mod P` where `k = x^(8 * n - 33) mod P`
+		// the carry-less product carries one extra x, the crc32 instruction multiplies by x^32 and reduces
+		const __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)), _mm_cvtsi32_si128(static_cast<int>(k)), 0x00);
+#if (defined(__x86_64__) || defined(_M_X64))
+		return static_cast<uint32_t>(_mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(prod))));
+#else
+		const uint32_t low = static_cast<uint32_t>(_mm_cvtsi128_si32(prod));
+		const uint32_t high = static_cast<uint32_t>(_mm_extract_epi32(prod, 1));
+		return _mm_crc32_u32(_mm_crc32_u32(0, low), high);
+#endif
+	}
+
+	X86_TARGET_CHOCOBO1_HASH("sse4.2,pclmul")
+	inline uint32_t crc32cSse42(const uint32_t crc, const uint8_t *data, std::size_t length)
+	{
+		// the crc32 instruction has a latency of 3 cycles but a throughput of 1 per cycle,
+		// so hash 3 adjacent streams at once and merge them with `crc32cShift()`
+
+		const std::size_t WORD_SIZE = sizeof(Crc32cWordType);
+		Crc32cWordType h = crc;
+
+		#ifdef crc32cStreams
+		#error "macro name clash"
+		#else
+		#define crc32cStreams(streamSize, kShift1, kShift2) \
+			while (length >= (3 * (streamSize))) \
+			{ \
+				Crc32cWordType h1 = 0; \
+				Crc32cWordType h2 = 0; \
+				for (std::size_t i = 0; i < (streamSize); i += WORD_SIZE) \
+				{ \
+					h = crc32cWord(h, (data + i)); \
+					h1 = crc32cWord(h1, (data + (streamSize) + i)); \
+					h2 = crc32cWord(h2, (data + (2 * (streamSize)) + i)); \
+				} \
+				h = crc32cShift(static_cast<uint32_t>(h), (kShift2)) \
+					^ crc32cShift(static_cast<uint32_t>(h1), (kShift1)) \
+					^ static_cast<uint32_t>(h2); \
+				data += (3 * (streamSize)); \
+				length -= (3 * (streamSize)); \
+			}
+
+		crc32cStreams(8192, 0x54a86326, 0x1dc403cc);  // x^(8 * 8192 - 33) mod P, x^(8 * 16384 - 33) mod P
+		crc32cStreams(256, 0xb9e02b86, 0xdd7e3b0c);  // x^(8 * 256 - 33) mod P, x^(8 * 512 - 33) mod P
+		#undef crc32cStreams
+		#endif
+
+		for (; length >= WORD_SIZE; length -= WORD_SIZE, data += WORD_SIZE)
+			h = crc32cWord(h, data);
+
+		uint32_t ret = static_cast<uint32_t>(h);
+		for (; length > 0; --length, ++data)
+			ret = _mm_crc32_u8(ret, *data);
+		return ret;
+	}
+#undef crc32cWord
+#endif
+#endif
+
+
+namespace CRC_32C_NS
+{
+	class CRC_32C
+	{
+		// Castagnoli polynomial 0x1EDC6F41 (0x82F63B78 reflected)
+		// the portable code path is `Hash::CRC_NS::Slicer`, "Slicing-by-16"
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, 4>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr CRC_32C();
+
+			constexpr void reset();
+			constexpr CRC_32C& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			constexpr CRC_32C& addData(Span<const Byte> inData);
+			constexpr CRC_32C& addData(const void *ptr, std::size_t length);
+			// same as `addData()` but a large input is split into pieces hashed on the shared worker threads
+			// `pieces == 0` means one piece per thread of the pool
+			CRC_32C& addDataParallel(Span<const Byte> inData, unsigned int pieces = 0);
+			template <std::size_t N>
+			constexpr CRC_32C& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			CRC_32C& addData(const T (&array)[N]);
+			template <typename T>
+			CRC_32C& addData(Span<T> inSpan);
+
+			// returns the CRC of `A || B` from the CRC of `A` and the CRC & length of `B`, CRCs are the finalized values
+			static constexpr uint32_t combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB);
+
+			friend constexpr bool operator==(const CRC_32C &left, const CRC_32C &right)
+			{
+				return (left.m_h == right.m_h);
+			}
+			friend constexpr bool operator!=(const CRC_32C &left, const CRC_32C &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			constexpr void addDataImpl(Span<const Byte> data);
+
+			using Slicer = Hash::CRC_NS::Slicer<32, 0x1EDC6F41, true, 16>;
+
+			uint32_t m_h = 0;
+	};
+
+
+	//
+	constexpr CRC_32C::CRC_32C()
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		reset();
+	}
+
+	constexpr void CRC_32C::reset()
+	{
+		m_h = 0;
+		m_h = ~m_h;
+	}
+
+	constexpr CRC_32C& CRC_32C::finalize()
+	{
+		m_h = ~m_h;
+		return (*this);
+	}
+
+	inline std::string CRC_32C::toString() const
+	{
+		const auto digest = toArray();
+		std::string ret;
+		ret.resize(2 * digest.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : digest)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
+
+		return ret;
+	}
+
+	inline std::vector<CRC_32C::Byte> CRC_32C::toVector() const
+	{
+		const auto digest = toArray();
+		return {digest.begin(), digest.end()};
+	}
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline CRC_32C::ResultArrayType CRC_32C::toArray() const
+	{
+		const int dataSize = sizeof(m_h);
+
+		ResultArrayType ret {};
+		auto *retPtr = ret.data();
+		for (int j = (dataSize - 1); j >= 0; --j)
+			*(retPtr++) = ror<Byte>(m_h, (j * 8));
+
+		return ret;
+	}
+
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH CRC_32C::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	constexpr CRC_32C& CRC_32C::addData(const Span<const Byte> inData)
+	{
+		addDataImpl(inData);
+		return (*this);
+	}
+
+	constexpr CRC_32C& CRC_32C::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	constexpr CRC_32C& CRC_32C::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	CRC_32C& CRC_32C::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	CRC_32C& CRC_32C::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	constexpr uint32_t CRC_32C::combine(const uint32_t crcA, const uint32_t crcB, const uint64_t lengthB)
+	{
+		// CRC(A || B) = (CRC(A) * x^(8 * lengthB) mod P) ^ CRC(B), the initial value and the final XOR cancel out
+		return (Hash::CRC_NS::shiftZeroBytes<32, 0x1EDC6F41>(crcA, lengthB) ^ crcB);
+	}
+
+	inline CRC_32C& CRC_32C::addDataParallel(const Span<const Byte> inData, const unsigned int pieces)
+	{
+		// `m_h` isn't finalized, the CRCs of the pieces are
+		m_h = ~Hash::CRC_NS::addDataParallel<CRC_32C>(static_cast<uint32_t>(~m_h), inData, pieces);
+		return *this;
+	}
+
+	constexpr void CRC_32C::addDataImpl(const Span<const Byte> data)
+	{
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (!isConstantEvaluated() && cpuFeatures().sse42 && cpuFeatures().pclmul)
+		{
+			m_h = crc32cSse42(m_h, data.data(), static_cast<size_t>(data.size()));
+			return;
+		}
+#endif
+
+		m_h = Slicer::update(m_h, data.data(), static_cast<size_t>(data.size()));
+	}
+}
+}
+
+	using CRC_32C = Hash::CRC_32C_NS::CRC_32C;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::CRC_32C>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::CRC_32C &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_CRC_32C_H
@@ -17,7 +17,6 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
-#include <memory>
 #include <string>
 #include <vector>
 
@@ -67,7 +66,7 @@ namespace Hash
 
 namespace CShake_NS
 {
-	template <typename S, typename K, int P>
+	template <typename K, int P>
 	class CShake
 	{
 		// https://doi.org/10.6028/NIST.SP.800-185
@@ -84,15 +83,26 @@ namespace CShake_NS
 #endif
 
 
+			class Prefix
+			{
+				// the absorbed bytepad(encode_string(N) || encode_string(S)), can be shared by instances of any digest length
+				public:
+					Prefix(const std::string &name, const std::string &customize);
+
+				private:
+					friend class CShake;
+
+					bool m_customized = false;
+					K m_keccak = K(0);
+			};
+
+
 			explicit constexpr CShake(int digestLength, const std::string &name = {}, const std::string &customize = {});
-			constexpr CShake(const CShake &other);
-			constexpr CShake(CShake &&other) noexcept;
-			constexpr CShake& operator=(const CShake &other);
-			constexpr CShake& operator=(CShake &&other) noexcept;
-			~CShake() = default;
+			static CShake fromPrefix(const Prefix &prefix, int digestLength);  // skips absorbing N & S again
 
 			constexpr void reset();
-			constexpr CShake& finalize();  // after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
+			constexpr CShake& finalize();  // after this, only `operator T()`, `reset()`, `squeeze()`, `toString()`, `toVector()` are available
+			CShake& squeeze(Span<Byte> out);  // writes the next `out.size()` bytes of the output stream, can be called repeatedly
 
 			std::string toString() const;
 			std::vector<Byte> toVector() const;
@@ -110,9 +120,8 @@ namespace CShake_NS
 
 			friend constexpr bool operator==(const CShake &left, const CShake &right)
 			{
-				if (left.m_customized != right.m_customized)
-					return false;
-				return left.m_customized ? (*(left.m_keccak) == *(right.m_keccak)) : (*(left.m_shake) == *(right.m_shake));
+				return ((left.m_customized == right.m_customized)
+					&& (left.m_keccak == right.m_keccak));
 			}
 			friend constexpr bool operator!=(const CShake &left, const CShake &right)
 			{
@@ -120,12 +129,13 @@ namespace CShake_NS
 			}
 
 		private:
+			static constexpr Byte SHAKE_PADDING = 0x1F;  // cSHAKE with empty N & S is SHAKE, which differs only in the suffix
+
 			constexpr void addDataImpl(Span<const Byte> data);
 
+			// a single sponge held inline, so construction & copies don't allocate
 			bool m_customized = false;
-
-			std::unique_ptr<S> m_shake;
-			std::unique_ptr<K> m_keccak;
+			K m_keccak;
 	};
 
 
@@ -143,20 +153,16 @@ namespace CShake_NS
 
 
 	//
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>::CShake(const int digestLength, const std::string &name, const std::string &customize)
+	template <typename K, int P>
+	constexpr CShake<K, P>::CShake(const int digestLength, const std::string &name, const std::string &customize)
 		: m_customized(!(name.empty() && customize.empty()))
+		, m_keccak(m_customized ? K(digestLength) : K(digestLength, SHAKE_PADDING))
 	{
 		static_assert((P >= 0), "Template parameter value invalid: P");
 		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
 
 		if (!m_customized)
-		{
-			m_shake = std::make_unique<S>(digestLength);
 			return;
-		}
-
-		m_keccak = std::make_unique<K>(digestLength);
 
 		const auto processString = [this](const std::string &str, size_t &length) -> void
 		{
@@ -185,94 +191,61 @@ namespace CShake_NS
 			addData({zero.data(), zero.size()});
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>::CShake(const CShake<S, K, P> &other)
-		: m_customized(other.m_customized)
-	{
-		if (!m_customized)
-			m_shake = std::make_unique<S>(*other.m_shake);
-		else
-			m_keccak = std::make_unique<K>(*other.m_keccak);
-	}
-
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>::CShake(CShake<S, K, P> &&other) noexcept
+	template <typename K, int P>
+	CShake<K, P>::Prefix::Prefix(const std::string &name, const std::string &customize)
 	{
-		std::swap(m_customized, other.m_customized);
-		if (!m_customized)
-			std::swap(m_shake, other.m_shake);
-		else
-			std::swap(m_keccak, other.m_keccak);
+		const CShake absorbed(0, name, customize);
+		m_customized = absorbed.m_customized;
+		m_keccak = absorbed.m_keccak;
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::operator=(const CShake<S, K, P> &other)
+	template <typename K, int P>
+	CShake<K, P> CShake<K, P>::fromPrefix(const Prefix &prefix, const int digestLength)
 	{
-		if (this != &other)
+		CShake ret(digestLength);
+		if (prefix.m_customized)
 		{
-			m_customized = other.m_customized;
-			if (!m_customized)
-				*m_shake = *other.m_shake;
-			else
-				*m_keccak = *other.m_keccak;
+			ret.m_customized = true;
+			ret.m_keccak = K(prefix.m_keccak, digestLength);
 		}
-		return *this;
+		return ret;
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::operator=(CShake<S, K, P> &&other) noexcept
+	template <typename K, int P>
+	constexpr void CShake<K, P>::reset()
 	{
-		if (this != &other)
-		{
-			std::swap(m_customized, other.m_customized);
-			if (!m_customized)
-				std::swap(m_shake, other.m_shake);
-			else
-				std::swap(m_keccak, other.m_keccak);
-		}
-		return *this;
+		m_keccak.reset();
 	}
 
-	template <typename S, typename K, int P>
-	constexpr void CShake<S, K, P>::reset()
+	template <typename K, int P>
+	constexpr CShake<K, P>& CShake<K, P>::finalize()
 	{
-		if (!m_customized)
-			m_shake->reset();
-		else
-			m_keccak->reset();
+		m_keccak.finalize();
+		return (*this);
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::finalize()
+	template <typename K, int P>
+	CShake<K, P>& CShake<K, P>::squeeze(const Span<Byte> out)
 	{
-		if (!m_customized)
-			m_shake->finalize();
-		else
-			m_keccak->finalize();
+		m_keccak.squeeze(out);
 		return (*this);
 	}
 
-	template <typename S, typename K, int P>
-	std::string CShake<S, K, P>::toString() const
+	template <typename K, int P>
+	std::string CShake<K, P>::toString() const
 	{
-		if (!m_customized)
-			return m_shake->toString();
-		else
-			return m_keccak->toString();
+		return m_keccak.toString();
 	}
 
-	template <typename S, typename K, int P>
-	std::vector<typename CShake<S, K, P>::Byte> CShake<S, K, P>::toVector() const
+	template <typename K, int P>
+	std::vector<typename CShake<K, P>::Byte> CShake<K, P>::toVector() const
 	{
-		if (!m_customized)
-			return m_shake->toVector();
-		else
-			return m_keccak->toVector();
+		return m_keccak.toVector();
 	}
 
-	template <typename S, typename K, int P>
+	template <typename K, int P>
 	template <typename T>
-	CShake<S, K, P>::operator T() const noexcept
+	CShake<K, P>::operator T() const noexcept
 	{
 		static_assert(std::is_unsigned<T>::value, "");
 
@@ -286,48 +259,45 @@ namespace CShake_NS
 		return ret;
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::addData(const Span<const Byte> inData)
+	template <typename K, int P>
+	constexpr CShake<K, P>& CShake<K, P>::addData(const Span<const Byte> inData)
 	{
 		addDataImpl(inData);
 		return (*this);
 	}
 
-	template <typename S, typename K, int P>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::addData(const void *ptr, const std::size_t length)
+	template <typename K, int P>
+	constexpr CShake<K, P>& CShake<K, P>::addData(const void *ptr, const std::size_t length)
 	{
 		// Span::size_type = std::size_t
 		return addData({static_cast<const Byte*>(ptr), length});
 	}
 
-	template <typename S, typename K, int P>
+	template <typename K, int P>
 	template <std::size_t N>
-	constexpr CShake<S, K, P>& CShake<S, K, P>::addData(const Byte (&array)[N])
+	constexpr CShake<K, P>& CShake<K, P>::addData(const Byte (&array)[N])
 	{
 		return addData({array, N});
 	}
 
-	template <typename S, typename K, int P>
+	template <typename K, int P>
 	template <typename T, std::size_t N>
-	CShake<S, K, P>& CShake<S, K, P>::addData(const T (&array)[N])
+	CShake<K, P>& CShake<K, P>::addData(const T (&array)[N])
 	{
 		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
 	}
 
-	template <typename S, typename K, int P>
+	template <typename K, int P>
 	template <typename T>
-	CShake<S, K, P>& CShake<S, K, P>::addData(const Span<T> inSpan)
+	CShake<K, P>& CShake<K, P>::addData(const Span<T> inSpan)
 	{
 		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
 	}
 
-	template <typename S, typename K, int P>
-	constexpr void CShake<S, K, P>::addDataImpl(const Span<const Byte> data)
+	template <typename K, int P>
+	constexpr void CShake<K, P>::addDataImpl(const Span<const Byte> data)
 	{
-		if (!m_customized)
-			m_shake->addData(data);
-		else
-			m_keccak->addData(data);
+		m_keccak.addData(data);
 	}
 }
 }
@@ -341,17 +311,18 @@ namespace CShake_NS
 		CSHAKEAlias(Base &&other) noexcept : Base(std::move(other)) {}
 		CSHAKEAlias& operator=(const Base &other) { if (this != &other) { Base::operator=(other); } return *this; }
 		CSHAKEAlias& operator=(Base &&other) noexcept { if (this != &other) { Base::operator=(std::move(other)); } return *this; }
+		static CSHAKEAlias fromPrefix(const typename Base::Prefix &p, const int l) { return CSHAKEAlias(Base::fromPrefix(p, l)); }
 	};
-	using CSHAKE_128 = CSHAKEAlias<Hash::CShake_NS::CShake<SHAKE_128, Hash::SHA3_NS::Keccak<(1344 / 8), 0x04>, (1344 / 8)>>;
-	using CSHAKE_256 = CSHAKEAlias<Hash::CShake_NS::CShake<SHAKE_256, Hash::SHA3_NS::Keccak<(1088 / 8), 0x04>, (1088 / 8)>>;
+	using CSHAKE_128 = CSHAKEAlias<Hash::CShake_NS::CShake<Hash::SHA3_NS::Keccak<(1344 / 8), 0x04>, (1344 / 8)>>;
+	using CSHAKE_256 = CSHAKEAlias<Hash::CShake_NS::CShake<Hash::SHA3_NS::Keccak<(1088 / 8), 0x04>, (1088 / 8)>>;
 }
 
 namespace std
 {
-	template <typename S, typename K, int P>
-	struct hash<Chocobo1::Hash::CShake_NS::CShake<S, K, P>>
+	template <typename K, int P>
+	struct hash<Chocobo1::Hash::CShake_NS::CShake<K, P>>
 	{
-		size_t operator()(const Chocobo1::Hash::CShake_NS::CShake<S, K, P> &hash) const noexcept
+		size_t operator()(const Chocobo1::Hash::CShake_NS::CShake<K, P> &hash) const noexcept
 		{
 			return hash;
 		}
@@ -0,0 +1,334 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_ED2K_H
+#define CHOCOBO1_ED2K_H
+
+#include "md4.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// ED2K(const bool emptyLastChunk = false);
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+namespace ED2K_NS
+{
+	class ED2K
+	{
+		// https://en.wikipedia.org/wiki/Ed2k_URI_scheme#eD2k_hash_algorithm
+		// the input is cut into 9,728,000 bytes chunks, the result is the MD4 of the chunk MD4 digests,
+		// or the MD4 of the input when there is only 1 chunk
+		// `emptyLastChunk`: when the input size is a multiple of the chunk size, also add the digest of an empty chunk,
+		// as original eDonkey2000 clients do (known as the "red" hash)
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = MD4::ResultArrayType;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			explicit ED2K(bool emptyLastChunk = false);
+
+			void reset();
+			ED2K& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			ResultArrayType toArray() const;
+			template <typename T>
+			operator T() const noexcept;
+
+			ED2K& addData(Span<const Byte> inData);  // filled chunks are hashed on the shared worker threads, a few at a time
+			ED2K& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			ED2K& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			ED2K& addData(const T (&array)[N]);
+			template <typename T>
+			ED2K& addData(Span<T> inSpan);
+
+			friend bool operator==(const ED2K &left, const ED2K &right)
+			{
+				return ((left.chunkDigests() == right.chunkDigests())
+					&& (left.m_buffer == right.m_buffer)
+					&& (left.m_result == right.m_result));
+			}
+			friend bool operator!=(const ED2K &left, const ED2K &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static constexpr std::size_t CHUNK_SIZE = 9728000;
+
+			void addDataImpl(Span<const Byte> data);
+			void addChunk(std::vector<Byte> &&chunk);
+			void addChunks(Span<const Byte> data);
+			void hashPending();
+			std::vector<ResultArrayType> chunkDigests() const;
+			static ResultArrayType hashChunk(Span<const Byte> chunk);
+
+			bool m_emptyLastChunk = false;
+
+			std::vector<Byte> m_buffer;  // current chunk
+			std::vector<ResultArrayType> m_digests;  // of the hashed chunks, in order
+			std::vector<std::vector<Byte>> m_pending;  // filled chunks not hashed yet, they follow `m_digests`
+
+			ResultArrayType m_result {};
+	};
+
+
+	//
+	inline ED2K::ED2K(const bool emptyLastChunk)
+		: m_emptyLastChunk(emptyLastChunk)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+	}
+
+	inline void ED2K::reset()
+	{
+		m_pending.clear();
+		m_buffer.clear();
+		m_digests.clear();
+		m_result = {};
+	}
+
+	inline ED2K& ED2K::finalize()
+	{
+		hashPending();
+
+		// `m_buffer` holds the last chunk
+		const bool addEmptyChunk = m_emptyLastChunk && (m_buffer.size() == CHUNK_SIZE);
+		m_digests.emplace_back(hashChunk(m_buffer));
+		if (addEmptyChunk)
+			m_digests.emplace_back(hashChunk({}));
+
+		if (m_digests.size() == 1)
+		{
+			m_result = m_digests.front();
+		}
+		else
+		{
+			MD4 root;
+			for (const auto &digest : m_digests)
+				root.addData(digest.data(), digest.size());
+			m_result = root.finalize().toArray();
+		}
+
+		m_buffer.clear();
+		m_digests.clear();
+
+		return (*this);
+	}
+
+	inline std::string ED2K::toString() const
+	{
+		std::string ret;
+		ret.resize(2 * m_result.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : m_result)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
+
+		return ret;
+	}
+
+	inline std::vector<ED2K::Byte> ED2K::toVector() const
+	{
+		return {m_result.begin(), m_result.end()};
+	}
+
+	inline ED2K::ResultArrayType ED2K::toArray() const
+	{
+		return m_result;
+	}
+
+	template <typename T>
+	ED2K::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), m_result.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= m_result[i];
+		}
+		return ret;
+	}
+
+	inline ED2K& ED2K::addData(const Span<const Byte> inData)
+	{
+		addDataImpl(inData);
+		return (*this);
+	}
+
+	inline ED2K& ED2K::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	ED2K& ED2K::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	ED2K& ED2K::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	ED2K& ED2K::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	inline void ED2K::addDataImpl(const Span<const Byte> inData)
+	{
+		// a full chunk is passed on only when more data follows, the last chunk stays in `m_buffer` for `finalize()`
+		Span<const Byte> data = inData;
+		while (!data.empty())
+		{
+			if (m_buffer.size() == CHUNK_SIZE)
+			{
+				addChunk(std::move(m_buffer));
+				m_buffer = {};
+			}
+
+			if (m_buffer.empty() && (static_cast<std::size_t>(data.size()) > CHUNK_SIZE))
+			{
+				// whole chunks are hashed straight from the input
+				const std::size_t len = ((static_cast<std::size_t>(data.size()) - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+				addChunks(data.first(len));
+				data = data.subspan(len);
+				continue;
+			}
+
+			const std::size_t len = std::min((CHUNK_SIZE - m_buffer.size()), static_cast<std::size_t>(data.size()));
+			m_buffer.insert(m_buffer.end(), data.begin(), (data.begin() + len));
+			data = data.subspan(len);
+		}
+	}
+
+	inline void ED2K::addChunk(std::vector<Byte> &&chunk)
+	{
+		// the chunks are hashed together once there is 1 per thread of the pool, so memory usage stays bounded
+		m_pending.emplace_back(std::move(chunk));
+		if (m_pending.size() > threadPool().workerCount())
+			hashPending();
+	}
+
+	inline void ED2K::addChunks(const Span<const Byte> data)
+	{
+		// `data` holds whole chunks only and isn't owned, so these are done before returning
+		hashPending();
+
+		const std::size_t offset = m_digests.size();
+		m_digests.resize(offset + (static_cast<std::size_t>(data.size()) / CHUNK_SIZE));
+		threadPool().parallelFor((m_digests.size() - offset), [this, &data, offset](const std::size_t idx) -> void
+		{
+			m_digests[offset + idx] = hashChunk(data.subspan((idx * CHUNK_SIZE), CHUNK_SIZE));
+		});
+	}
+
+	inline void ED2K::hashPending()
+	{
+		const std::size_t offset = m_digests.size();
+		m_digests.resize(offset + m_pending.size());
+		threadPool().parallelFor(m_pending.size(), [this, offset](const std::size_t idx) -> void
+		{
+			m_digests[offset + idx] = hashChunk(m_pending[idx]);
+		});
+		m_pending.clear();
+	}
+
+	inline std::vector<ED2K::ResultArrayType> ED2K::chunkDigests() const
+	{
+		std::vector<ResultArrayType> ret = m_digests;
+		for (const auto &pending : m_pending)
+			ret.emplace_back(hashChunk(pending));
+		return ret;
+	}
+
+	inline ED2K::ResultArrayType ED2K::hashChunk(const Span<const Byte> chunk)
+	{
+		return MD4().addData(chunk).finalize().toArray();
+	}
+}
+}
+
+	using ED2K = Hash::ED2K_NS::ED2K;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::ED2K>
+	{
+		size_t operator()(const Chocobo1::ED2K &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_ED2K_H
@@ -0,0 +1,341 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_KANGAROO_TWELVE_H
+#define CHOCOBO1_KANGAROO_TWELVE_H
+
+#include "sha3.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// KangarooTwelve(const int digestLengthInBytes = 32, const std::string &customize = {});
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+namespace KangarooTwelve_NS
+{
+	class KangarooTwelve
+	{
+		// https://www.rfc-editor.org/rfc/rfc9861, KT128
+		// S = M || C || length_encode(|C|) is cut into 8 KiB chunks, every chunk after the first is hashed on its own,
+		// the first chunk & the chaining values of the others are hashed by the final node
+
+		public:
+			using Byte = uint8_t;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			explicit KangarooTwelve(int digestLength = 32, const std::string &customize = {});
+
+			void reset();
+			KangarooTwelve& finalize();  // after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			template <typename T>
+			operator T() const noexcept;
+
+			KangarooTwelve& addData(Span<const Byte> inData);  // large inputs hash the chunks on separate threads
+			KangarooTwelve& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			KangarooTwelve& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			KangarooTwelve& addData(const T (&array)[N]);
+			template <typename T>
+			KangarooTwelve& addData(Span<T> inSpan);
+
+			friend bool operator==(const KangarooTwelve &left, const KangarooTwelve &right)
+			{
+				return ((left.m_chunkCount == right.m_chunkCount)
+					&& (left.m_buffer == right.m_buffer)
+					&& (left.m_node == right.m_node)
+					&& (left.m_single == right.m_single)
+					&& (left.m_customize == right.m_customize));
+			}
+			friend bool operator!=(const KangarooTwelve &left, const KangarooTwelve &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			// TurboSHAKE128 with the domain separation bytes used by the tree
+			using Leaf = SHA3_NS::Keccak<(1344 / 8), 0x0B, 12>;
+			using Node = SHA3_NS::Keccak<(1344 / 8), 0x06, 12>;
+			using Single = SHA3_NS::Keccak<(1344 / 8), 0x07, 12>;
+
+			static constexpr std::size_t CHUNK_SIZE = 8192;
+			static constexpr int CV_SIZE = 32;
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller inputs aren't worth the threads
+			static constexpr std::size_t TASK_SIZE = 256 * 1024;  // a large input is handed to the workers in pieces of about this size
+
+			void addDataImpl(Span<const Byte> data);
+			void addChunk(Span<const Byte> chunk);
+			void addLeaves(Span<const Byte> data, bool parallel);
+			static void hashLeaves(Span<const Byte> data, Byte *cvs);
+
+			Node m_node;
+			Single m_single;  // used instead of `m_node` when S fits in 1 chunk
+			std::string m_customize;
+
+			std::vector<Byte> m_buffer;  // current chunk
+			uint64_t m_chunkCount = 0;  // chunks passed to `m_node`
+	};
+
+
+	// helpers
+	const auto lengthEncode = [](const uint64_t value) -> Buffer<uint8_t, (sizeof(value) + 1)>
+	{
+		uint8_t n = 0;
+		for (uint64_t v = value; v > 0; v >>= 8)
+			++n;
+
+		Buffer<uint8_t, (sizeof(value) + 1)> ret;
+		for (int i = (n - 1); i >= 0; --i)
+			ret.fill(static_cast<uint8_t>(value >> (8 * i)));
+		ret.fill(n);
+
+		return ret;
+	};
+
+
+	//
+	inline KangarooTwelve::KangarooTwelve(const int digestLength, const std::string &customize)
+		: m_node(digestLength)
+		, m_single(digestLength)
+		, m_customize(customize)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+
+		m_buffer.reserve(CHUNK_SIZE);
+	}
+
+	inline void KangarooTwelve::reset()
+	{
+		m_node.reset();
+		m_single.reset();
+		m_buffer.clear();
+		m_chunkCount = 0;
+	}
+
+	inline KangarooTwelve& KangarooTwelve::finalize()
+	{
+		addDataImpl({reinterpret_cast<const Byte*>(m_customize.data()), m_customize.size()});
+		const auto encodedLength = lengthEncode(m_customize.size());
+		addDataImpl({encodedLength.data(), encodedLength.size()});
+
+		// `m_buffer` holds the last chunk
+		if (m_chunkCount == 0)
+		{
+			m_single.addData(m_buffer).finalize();
+		}
+		else
+		{
+			m_node.addData(Leaf(CV_SIZE).addData(m_buffer).finalize().toVector());
+
+			const auto encodedCount = lengthEncode(m_chunkCount);
+			const Byte terminator[2] = {0xFF, 0xFF};
+			m_node.addData({encodedCount.data(), encodedCount.size()}).addData(terminator).finalize();
+		}
+		m_buffer.clear();
+
+		return (*this);
+	}
+
+	inline std::string KangarooTwelve::toString() const
+	{
+		return (m_chunkCount == 0) ? m_single.toString() : m_node.toString();
+	}
+
+	inline std::vector<KangarooTwelve::Byte> KangarooTwelve::toVector() const
+	{
+		return (m_chunkCount == 0) ? m_single.toVector() : m_node.toVector();
+	}
+
+	template <typename T>
+	KangarooTwelve::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toVector();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	inline KangarooTwelve& KangarooTwelve::addData(const Span<const Byte> inData)
+	{
+		addDataImpl(inData);
+		return (*this);
+	}
+
+	inline KangarooTwelve& KangarooTwelve::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	KangarooTwelve& KangarooTwelve::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	KangarooTwelve& KangarooTwelve::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	KangarooTwelve& KangarooTwelve::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	inline void KangarooTwelve::addDataImpl(const Span<const Byte> inData)
+	{
+		// a full chunk is passed on only when more data follows, the last chunk stays in `m_buffer` for `finalize()`
+		// decided on the whole input, the chunks passed on are fewer and would miss the threshold with fixed size reads
+		const bool parallel = (static_cast<std::size_t>(inData.size()) >= MIN_PARALLEL_SIZE);
+
+		Span<const Byte> data = inData;
+		while (!data.empty())
+		{
+			if (m_buffer.size() == CHUNK_SIZE)
+			{
+				addChunk(m_buffer);
+				m_buffer.clear();
+			}
+
+			if (m_buffer.empty() && (m_chunkCount > 0) && (static_cast<std::size_t>(data.size()) > CHUNK_SIZE))
+			{
+				// whole chunks are hashed straight from the input
+				const std::size_t len = ((static_cast<std::size_t>(data.size()) - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+				addLeaves(data.first(len), parallel);
+				data = data.subspan(len);
+				continue;
+			}
+
+			const std::size_t len = std::min((CHUNK_SIZE - m_buffer.size()), static_cast<std::size_t>(data.size()));
+			m_buffer.insert(m_buffer.end(), data.begin(), (data.begin() + len));
+			data = data.subspan(len);
+		}
+	}
+
+	inline void KangarooTwelve::addChunk(const Span<const Byte> chunk)
+	{
+		if (m_chunkCount == 0)
+		{
+			const Byte marker[8] = {0x03};
+			m_node.addData(chunk).addData(marker);
+		}
+		else
+		{
+			m_node.addData(Leaf(CV_SIZE).addData(chunk).finalize().toVector());
+		}
+		++m_chunkCount;
+	}
+
+	inline void KangarooTwelve::addLeaves(const Span<const Byte> data, const bool parallel)
+	{
+		// `data` holds whole chunks only, their chaining values are absorbed in order
+		const std::size_t chunks = static_cast<std::size_t>(data.size()) / CHUNK_SIZE;
+
+		std::vector<Byte> cvs(chunks * CV_SIZE);
+
+		const std::size_t tasks = parallel
+			? std::min(chunks, std::max<std::size_t>((static_cast<std::size_t>(data.size()) / TASK_SIZE), 1))
+			: 1;
+		threadPool().parallelFor(tasks, [&](const std::size_t i) -> void
+		{
+			const std::size_t first = (chunks * i) / tasks;
+			const std::size_t last = (chunks * (i + 1)) / tasks;
+			hashLeaves(data.subspan((first * CHUNK_SIZE), ((last - first) * CHUNK_SIZE)), (cvs.data() + (first * CV_SIZE)));
+		});
+
+		m_node.addData(cvs);
+		m_chunkCount += chunks;
+	}
+
+	inline void KangarooTwelve::hashLeaves(const Span<const Byte> data, Byte *cvs)
+	{
+		// `Leaf::hashBatch()` spreads the chunks over SIMD lanes when supported
+		std::vector<Span<const Byte>> chunks;
+		chunks.reserve(static_cast<std::size_t>(data.size()) / CHUNK_SIZE);
+		for (std::size_t i = 0; i < static_cast<std::size_t>(data.size()); i += CHUNK_SIZE)
+			chunks.emplace_back(data.subspan(i, CHUNK_SIZE));
+
+		for (const auto &cv : Leaf::hashBatch(CV_SIZE, chunks))
+			cvs = std::copy(cv.begin(), cv.end(), cvs);
+	}
+}
+}
+
+	using KangarooTwelve = Hash::KangarooTwelve_NS::KangarooTwelve;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::KangarooTwelve>
+	{
+		size_t operator()(const Chocobo1::KangarooTwelve &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_KANGAROO_TWELVE_H
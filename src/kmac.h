@@ -0,0 +1,341 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_KMAC_H
+#define CHOCOBO1_KMAC_H
+
+#include "cshake.h"
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// KMAC_128(const int digestLengthInBytes, Span<const Byte> key, const std::string &customize = {});
+	// KMAC_256(const int digestLengthInBytes, Span<const Byte> key, const std::string &customize = {});
+	// KMACXOF_128(const int digestLengthInBytes, Span<const Byte> key, const std::string &customize = {});
+	// KMACXOF_256(const int digestLengthInBytes, Span<const Byte> key, const std::string &customize = {});
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+namespace Hash
+{
+#ifndef CHOCOBO1_HASH_ROR_IMPL
+#define CHOCOBO1_HASH_ROR_IMPL
+	template <typename R, typename T>
+	constexpr R ror(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<R>::value, "");
+		static_assert(std::is_unsigned<T>::value, "");
+		return static_cast<R>(x >> s);
+	}
+#endif
+
+
+namespace KMAC_NS
+{
+	template <typename Alg, int R, bool XOF>
+	class KMAC
+	{
+		// https://doi.org/10.6028/NIST.SP.800-185
+		// the keyed state is computed once in the constructor, copies share it so cloning an instance per message is cheap
+
+		public:
+			using Byte = uint8_t;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			KMAC(int digestLength, Span<const Byte> key, const std::string &customize = {});
+
+			void reset();  // back to the keyed state
+			KMAC& finalize();  // after this, only `operator T()`, `reset()`, `squeeze()`, `toString()`, `toVector()` are available
+			KMAC& squeeze(Span<Byte> out);  // KMACXOF only: writes the next `out.size()` bytes of the output stream, can be called repeatedly
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			template <typename T>
+			operator T() const noexcept;
+
+			KMAC& addData(Span<const Byte> inData);
+			KMAC& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			KMAC& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			KMAC& addData(const T (&array)[N]);
+			template <typename T>
+			KMAC& addData(Span<T> inSpan);
+
+			friend bool operator==(const KMAC &left, const KMAC &right)
+			{
+				return ((left.m_cshake == right.m_cshake)
+					&& (left.m_squeezing == right.m_squeezing));
+			}
+			friend bool operator!=(const KMAC &left, const KMAC &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static Alg keyedState(int digestLength, Span<const Byte> key, const std::string &customize);
+			void addOutputLength();
+
+			std::shared_ptr<const Alg> m_keyed;
+			Alg m_cshake;
+			int m_digestLength = 0;
+			bool m_squeezing = false;  // the output length is encoded
+	};
+
+
+	// helpers
+	const auto rightEncode = [](const uint64_t value) -> Buffer<uint8_t, (sizeof(value) + 1)>
+	{
+		const uint8_t n = (value == 0) ? 1 : static_cast<uint8_t>(std::lround((std::log2(value) / 8) + 0.5));
+
+		Buffer<uint8_t, (sizeof(value) + 1)> ret;
+		for (int i = (n - 1); i >= 0; --i)
+			ret.fill(ror<uint8_t>(value, (8 * i)));
+		ret.fill(n);
+
+		return ret;
+	};
+
+
+	//
+	template <typename Alg, int R, bool XOF>
+	KMAC<Alg, R, XOF>::KMAC(const int digestLength, const Span<const Byte> key, const std::string &customize)
+		: m_keyed(std::make_shared<const Alg>(keyedState(digestLength, key, customize)))
+		, m_cshake(*m_keyed)
+		, m_digestLength(digestLength)
+	{
+		static_assert((R > 0), "Template parameter value invalid: R");
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+	}
+
+	template <typename Alg, int R, bool XOF>
+	void KMAC<Alg, R, XOF>::reset()
+	{
+		m_cshake = *m_keyed;
+		m_squeezing = false;
+	}
+
+	template <typename Alg, int R, bool XOF>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::finalize()
+	{
+		if (!m_squeezing)
+			addOutputLength();
+		m_cshake.finalize();
+		return (*this);
+	}
+
+	template <typename Alg, int R, bool XOF>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::squeeze(const Span<Byte> out)
+	{
+		static_assert(XOF, "KMAC binds the output length into the output, use KMACXOF to squeeze");
+
+		if (!m_squeezing)
+			addOutputLength();
+		m_cshake.squeeze(out);
+		return (*this);
+	}
+
+	template <typename Alg, int R, bool XOF>
+	std::string KMAC<Alg, R, XOF>::toString() const
+	{
+		return m_cshake.toString();
+	}
+
+	template <typename Alg, int R, bool XOF>
+	std::vector<typename KMAC<Alg, R, XOF>::Byte> KMAC<Alg, R, XOF>::toVector() const
+	{
+		return m_cshake.toVector();
+	}
+
+	template <typename Alg, int R, bool XOF>
+	template <typename T>
+	KMAC<Alg, R, XOF>::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toVector();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	template <typename Alg, int R, bool XOF>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::addData(const Span<const Byte> inData)
+	{
+		m_cshake.addData(inData);
+		return (*this);
+	}
+
+	template <typename Alg, int R, bool XOF>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <typename Alg, int R, bool XOF>
+	template <std::size_t N>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename Alg, int R, bool XOF>
+	template <typename T, std::size_t N>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename Alg, int R, bool XOF>
+	template <typename T>
+	KMAC<Alg, R, XOF>& KMAC<Alg, R, XOF>::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	template <typename Alg, int R, bool XOF>
+	void KMAC<Alg, R, XOF>::addOutputLength()
+	{
+		// KMACXOF encodes an output length of 0
+		const auto encoded = rightEncode(XOF ? 0 : (static_cast<uint64_t>(m_digestLength) * 8));
+		m_cshake.addData({encoded.data(), encoded.size()});
+		m_squeezing = true;
+	}
+
+	template <typename Alg, int R, bool XOF>
+	Alg KMAC<Alg, R, XOF>::keyedState(const int digestLength, const Span<const Byte> key, const std::string &customize)
+	{
+		// absorb bytepad(encode_string(K), R)
+		Alg ret(digestLength, "KMAC", customize);
+
+		const auto encodedRate = Chocobo1::Hash::CShake_NS::leftEncode(R);
+		ret.addData({encodedRate.data(), encodedRate.size()});
+		const auto encodedKeyLength = Chocobo1::Hash::CShake_NS::leftEncode(static_cast<uint64_t>(key.size()) * 8);
+		ret.addData({encodedKeyLength.data(), encodedKeyLength.size()});
+		ret.addData(key);
+
+		const std::size_t length = encodedRate.size() + encodedKeyLength.size() + static_cast<std::size_t>(key.size());
+		const Buffer<Byte, 1> zero {0};
+		for (std::size_t i = 0, iMax = ((R - (length % R)) % R); i < iMax; ++i)
+			ret.addData({zero.data(), zero.size()});
+
+		return ret;
+	}
+}
+}
+
+	template <typename Base>
+	struct KMACAlias : Base
+	{
+		using BaseType = Base;
+		KMACAlias(const int l, const typename Base::template Span<const typename Base::Byte> k, const std::string &c = {}) : Base(l, k, c) {}
+		KMACAlias(const Base &other) : Base(other) {}
+		KMACAlias(Base &&other) noexcept : Base(std::move(other)) {}
+		KMACAlias& operator=(const Base &other) { if (this != &other) { Base::operator=(other); } return *this; }
+		KMACAlias& operator=(Base &&other) noexcept { if (this != &other) { Base::operator=(std::move(other)); } return *this; }
+	};
+	using KMAC_128 = KMACAlias<Hash::KMAC_NS::KMAC<CSHAKE_128, (1344 / 8), false>>;
+	using KMAC_256 = KMACAlias<Hash::KMAC_NS::KMAC<CSHAKE_256, (1088 / 8), false>>;
+	using KMACXOF_128 = KMACAlias<Hash::KMAC_NS::KMAC<CSHAKE_128, (1344 / 8), true>>;
+	using KMACXOF_256 = KMACAlias<Hash::KMAC_NS::KMAC<CSHAKE_256, (1088 / 8), true>>;
+}
+
+namespace std
+{
+	template <typename Alg, int R, bool XOF>
+	struct hash<Chocobo1::Hash::KMAC_NS::KMAC<Alg, R, XOF>>
+	{
+		size_t operator()(const Chocobo1::Hash::KMAC_NS::KMAC<Alg, R, XOF> &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::KMAC_128>
+	{
+		size_t operator()(const Chocobo1::KMAC_128 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::KMAC_256>
+	{
+		size_t operator()(const Chocobo1::KMAC_256 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::KMACXOF_128>
+	{
+		size_t operator()(const Chocobo1::KMACXOF_128 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::KMACXOF_256>
+	{
+		size_t operator()(const Chocobo1::KMACXOF_256 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_KMAC_H
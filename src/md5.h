@@ -12,6 +12,9 @@
 #ifndef CHOCOBO1_MD5_H
 #define CHOCOBO1_MD5_H
 
+#include "x86_simd.h"
+
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
@@ -186,6 +189,277 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_MD5_SIMD_IMPL
+#define CHOCOBO1_HASH_MD5_SIMD_IMPL
+	#ifdef md5SimdSteps
+	#error "macro name clash"
+	#else
+	// the 64 steps of `MD5::addDataImpl()`, each kernel supplies its own `step` & round functions
+	#define md5SimdSteps(step, F, G, H, I) \
+		step(F, a, b, c, d, 0, 7, 0xd76aa478); \
+		step(F, d, a, b, c, 1, 12, 0xe8c7b756); \
+		step(F, c, d, a, b, 2, 17, 0x242070db); \
+		step(F, b, c, d, a, 3, 22, 0xc1bdceee); \
+		step(F, a, b, c, d, 4, 7, 0xf57c0faf); \
+		step(F, d, a, b, c, 5, 12, 0x4787c62a); \
+		step(F, c, d, a, b, 6, 17, 0xa8304613); \
+		step(F, b, c, d, a, 7, 22, 0xfd469501); \
+		step(F, a, b, c, d, 8, 7, 0x698098d8); \
+		step(F, d, a, b, c, 9, 12, 0x8b44f7af); \
+		step(F, c, d, a, b, 10, 17, 0xffff5bb1); \
+		step(F, b, c, d, a, 11, 22, 0x895cd7be); \
+		step(F, a, b, c, d, 12, 7, 0x6b901122); \
+		step(F, d, a, b, c, 13, 12, 0xfd987193); \
+		step(F, c, d, a, b, 14, 17, 0xa679438e); \
+		step(F, b, c, d, a, 15, 22, 0x49b40821); \
+		\
+		step(G, a, b, c, d, 1, 5, 0xf61e2562); \
+		step(G, d, a, b, c, 6, 9, 0xc040b340); \
+		step(G, c, d, a, b, 11, 14, 0x265e5a51); \
+		step(G, b, c, d, a, 0, 20, 0xe9b6c7aa); \
+		step(G, a, b, c, d, 5, 5, 0xd62f105d); \
+		step(G, d, a, b, c, 10, 9, 0x02441453); \
+		step(G, c, d, a, b, 15, 14, 0xd8a1e681); \
+		step(G, b, c, d, a, 4, 20, 0xe7d3fbc8); \
+		step(G, a, b, c, d, 9, 5, 0x21e1cde6); \
+		step(G, d, a, b, c, 14, 9, 0xc33707d6); \
+		step(G, c, d, a, b, 3, 14, 0xf4d50d87); \
+		step(G, b, c, d, a, 8, 20, 0x455a14ed); \
+		step(G, a, b, c, d, 13, 5, 0xa9e3e905); \
+		step(G, d, a, b, c, 2, 9, 0xfcefa3f8); \
+		step(G, c, d, a, b, 7, 14, 0x676f02d9); \
+		step(G, b, c, d, a, 12, 20, 0x8d2a4c8a); \
+		\
+		step(H, a, b, c, d, 5, 4, 0xfffa3942); \
+		step(H, d, a, b, c, 8, 11, 0x8771f681); \
+		step(H, c, d, a, b, 11, 16, 0x6d9d6122); \
+		step(H, b, c, d, a, 14, 23, 0xfde5380c); \
+		step(H, a, b, c, d, 1, 4, 0xa4beea44); \
+		step(H, d, a, b, c, 4, 11, 0x4bdecfa9); \
+		step(H, c, d, a, b, 7, 16, 0xf6bb4b60); \
+		step(H, b, c, d, a, 10, 23, 0xbebfbc70); \
+		step(H, a, b, c, d, 13, 4, 0x289b7ec6); \
+		step(H, d, a, b, c, 0, 11, 0xeaa127fa); \
+		step(H, c, d, a, b, 3, 16, 0xd4ef3085); \
+		step(H, b, c, d, a, 6, 23, 0x04881d05); \
+		step(H, a, b, c, d, 9, 4, 0xd9d4d039); \
+		step(H, d, a, b, c, 12, 11, 0xe6db99e5); \
+		step(H, c, d, a, b, 15, 16, 0x1fa27cf8); \
+		step(H, b, c, d, a, 2, 23, 0xc4ac5665); \
+		\
+		step(I, a, b, c, d, 0, 6, 0xf4292244); \
+		step(I, d, a, b, c, 7, 10, 0x432aff97); \
+		step(I, c, d, a, b, 14, 15, 0xab9423a7); \
+		step(I, b, c, d, a, 5, 21, 0xfc93a039); \
+		step(I, a, b, c, d, 12, 6, 0x655b59c3); \
+		step(I, d, a, b, c, 3, 10, 0x8f0ccc92); \
+		step(I, c, d, a, b, 10, 15, 0xffeff47d); \
+		step(I, b, c, d, a, 1, 21, 0x85845dd1); \
+		step(I, a, b, c, d, 8, 6, 0x6fa87e4f); \
+		step(I, d, a, b, c, 15, 10, 0xfe2ce6e0); \
+		step(I, c, d, a, b, 6, 15, 0xa3014314); \
+		step(I, b, c, d, a, 13, 21, 0x4e0811a1); \
+		step(I, a, b, c, d, 4, 6, 0xf7537e82); \
+		step(I, d, a, b, c, 11, 10, 0xbd3af235); \
+		step(I, c, d, a, b, 2, 15, 0x2ad7d2bb); \
+		step(I, b, c, d, a, 9, 21, 0xeb86d391);
+
+	X86_TARGET_CHOCOBO1_HASH("sse2")
+	inline void md5CompressSse2x4(uint32_t (&states)[4][4], const uint8_t *const (&blocks)[4])
+	{
+		// compress 1 block of 4 independent messages, `states[i][j]` is word `i` of message `j`
+		// each register holds the same word of the 4 messages
+
+		__m128i x[16];
+		for (int i = 0; i < 4; ++i)
+		{
+			// transpose 4x4 words
+			const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[0] + (16 * i)));
+			const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[1] + (16 * i)));
+			const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[2] + (16 * i)));
+			const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[3] + (16 * i)));
+			const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+			const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+			const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+			const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+			x[(4 * i) + 0] = _mm_unpacklo_epi64(t0, t1);
+			x[(4 * i) + 1] = _mm_unpackhi_epi64(t0, t1);
+			x[(4 * i) + 2] = _mm_unpacklo_epi64(t2, t3);
+			x[(4 * i) + 3] = _mm_unpackhi_epi64(t2, t3);
+		}
+
+		const __m128i ones = _mm_set1_epi32(-1);
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states[0]));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states[1]));
+		__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states[2]));
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states[3]));
+		const __m128i a0 = a;
+		const __m128i b0 = b;
+		const __m128i c0 = c;
+		const __m128i d0 = d;
+
+		#ifdef md5Sse2Rotl
+		#error "macro name clash"
+		#else
+		#define md5Sse2Rotl(v, s) _mm_or_si128(_mm_slli_epi32((v), (s)), _mm_srli_epi32((v), (32 - (s))))
+
+		#ifdef md5Sse2F
+		#error "macro name clash"
+		#else
+		#define md5Sse2F(x, y, z) _mm_xor_si128(_mm_and_si128((x), _mm_xor_si128((y), (z))), (z))
+
+		#ifdef md5Sse2G
+		#error "macro name clash"
+		#else
+		#define md5Sse2G(x, y, z) _mm_xor_si128((y), _mm_and_si128(_mm_xor_si128((x), (y)), (z)))
+
+		#ifdef md5Sse2H
+		#error "macro name clash"
+		#else
+		#define md5Sse2H(x, y, z) _mm_xor_si128(_mm_xor_si128((x), (y)), (z))
+
+		#ifdef md5Sse2I
+		#error "macro name clash"
+		#else
+		#define md5Sse2I(x, y, z) _mm_xor_si128((y), _mm_or_si128((x), _mm_xor_si128((z), ones)))
+
+		#ifdef md5Sse2Step
+		#error "macro name clash"
+		#else
+		#define md5Sse2Step(func, a, b, c, d, k, s, t) \
+			a = _mm_add_epi32(b, md5Sse2Rotl(_mm_add_epi32(_mm_add_epi32(a, func(b, c, d)), _mm_add_epi32(x[k], _mm_set1_epi32(static_cast<int>(t)))), s))
+
+		md5SimdSteps(md5Sse2Step, md5Sse2F, md5Sse2G, md5Sse2H, md5Sse2I)
+
+		#undef md5Sse2Step
+		#endif
+		#undef md5Sse2I
+		#endif
+		#undef md5Sse2H
+		#endif
+		#undef md5Sse2G
+		#endif
+		#undef md5Sse2F
+		#endif
+		#undef md5Sse2Rotl
+		#endif
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(states[0]), _mm_add_epi32(a, a0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(states[1]), _mm_add_epi32(b, b0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(states[2]), _mm_add_epi32(c, c0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(states[3]), _mm_add_epi32(d, d0));
+	}
+
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline void md5CompressAvx2x8(uint32_t (&states)[4][8], const uint8_t *const (&blocks)[8])
+	{
+		// same as `md5CompressSse2x4()` with 8 messages
+
+		__m256i x[16];
+		for (int i = 0; i < 2; ++i)
+		{
+			// transpose 8x8 words
+			const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[0] + (32 * i)));
+			const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[1] + (32 * i)));
+			const __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[2] + (32 * i)));
+			const __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[3] + (32 * i)));
+			const __m256i r4 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[4] + (32 * i)));
+			const __m256i r5 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[5] + (32 * i)));
+			const __m256i r6 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[6] + (32 * i)));
+			const __m256i r7 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[7] + (32 * i)));
+			const __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+			const __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+			const __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+			const __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+			const __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+			const __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+			const __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+			const __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+			const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+			const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+			const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+			const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+			const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+			const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+			const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+			const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+			x[(8 * i) + 0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+			x[(8 * i) + 1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+			x[(8 * i) + 2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+			x[(8 * i) + 3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+			x[(8 * i) + 4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+			x[(8 * i) + 5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+			x[(8 * i) + 6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+			x[(8 * i) + 7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+		}
+
+		const __m256i ones = _mm256_set1_epi32(-1);
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[0]));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[1]));
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[2]));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[3]));
+		const __m256i a0 = a;
+		const __m256i b0 = b;
+		const __m256i c0 = c;
+		const __m256i d0 = d;
+
+		#ifdef md5Avx2Rotl
+		#error "macro name clash"
+		#else
+		#define md5Avx2Rotl(v, s) _mm256_or_si256(_mm256_slli_epi32((v), (s)), _mm256_srli_epi32((v), (32 - (s))))
+
+		#ifdef md5Avx2F
+		#error "macro name clash"
+		#else
+		#define md5Avx2F(x, y, z) _mm256_xor_si256(_mm256_and_si256((x), _mm256_xor_si256((y), (z))), (z))
+
+		#ifdef md5Avx2G
+		#error "macro name clash"
+		#else
+		#define md5Avx2G(x, y, z) _mm256_xor_si256((y), _mm256_and_si256(_mm256_xor_si256((x), (y)), (z)))
+
+		#ifdef md5Avx2H
+		#error "macro name clash"
+		#else
+		#define md5Avx2H(x, y, z) _mm256_xor_si256(_mm256_xor_si256((x), (y)), (z))
+
+		#ifdef md5Avx2I
+		#error "macro name clash"
+		#else
+		#define md5Avx2I(x, y, z) _mm256_xor_si256((y), _mm256_or_si256((x), _mm256_xor_si256((z), ones)))
+
+		#ifdef md5Avx2Step
+		#error "macro name clash"
+		#else
+		#define md5Avx2Step(func, a, b, c, d, k, s, t) \
+			a = _mm256_add_epi32(b, md5Avx2Rotl(_mm256_add_epi32(_mm256_add_epi32(a, func(b, c, d)), _mm256_add_epi32(x[k], _mm256_set1_epi32(static_cast<int>(t)))), s))
+
+		md5SimdSteps(md5Avx2Step, md5Avx2F, md5Avx2G, md5Avx2H, md5Avx2I)
+
+		#undef md5Avx2Step
+		#endif
+		#undef md5Avx2I
+		#endif
+		#undef md5Avx2H
+		#endif
+		#undef md5Avx2G
+		#endif
+		#undef md5Avx2F
+		#endif
+		#undef md5Avx2Rotl
+		#endif
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[0]), _mm256_add_epi32(a, a0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[1]), _mm256_add_epi32(b, b0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[2]), _mm256_add_epi32(c, c0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[3]), _mm256_add_epi32(d, d0));
+	}
+	#undef md5SimdSteps
+	#endif
+#endif
+#endif
+
 
 namespace MD5_NS
 {
@@ -226,6 +500,9 @@ namespace MD5_NS
 			template <typename T>
 			MD5& addData(Span<T> inSpan);
 
+			// hash independent messages, 8 (AVX2) or 4 (SSE2) at a time in SIMD lanes when supported, returns the digests in the same order
+			static std::vector<ResultArrayType> hashBatch(Span<const Span<const Byte>> messages);
+
 			friend constexpr bool operator==(const MD5 &left, const MD5 &right)
 			{
 				for (int i = 0; i < 4; ++i)
@@ -242,6 +519,10 @@ namespace MD5_NS
 
 		private:
 			CONSTEXPR_CPP17_CHOCOBO1_HASH void addDataImpl(Span<const Byte> data);
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+			template <int Lanes>
+			static void hashBatchLanes(Span<const Span<const Byte>> messages, ResultArrayType *digests, void (*compress)(uint32_t (&)[4][Lanes], const Byte *const (&)[Lanes]));
+#endif
 
 			static constexpr int BLOCK_SIZE = 64;
 
@@ -445,6 +726,140 @@ namespace MD5_NS
 		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
 	}
 
+	inline std::vector<MD5::ResultArrayType> MD5::hashBatch(const Span<const Span<const Byte>> messages)
+	{
+		std::vector<ResultArrayType> ret(static_cast<std::size_t>(messages.size()));
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (cpuFeatures().avx2)
+		{
+			hashBatchLanes<8>(messages, ret.data(), md5CompressAvx2x8);
+			return ret;
+		}
+		if (cpuFeatures().sse2)
+		{
+			hashBatchLanes<4>(messages, ret.data(), md5CompressSse2x4);
+			return ret;
+		}
+#endif
+
+		for (std::size_t i = 0; i < ret.size(); ++i)
+			ret[i] = MD5().addData(messages[i]).finalize().toArray();
+
+		return ret;
+	}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	template <int Lanes>
+	void MD5::hashBatchLanes(const Span<const Span<const Byte>> messages, ResultArrayType *digests, void (*compress)(uint32_t (&)[4][Lanes], const Byte *const (&)[Lanes]))
+	{
+		// each lane works on its own message and is refilled with the next message as soon as it finishes,
+		// so messages of different lengths keep all lanes busy. The padded tail is prepared per lane.
+
+		struct Lane
+		{
+			bool busy = false;
+			std::size_t message = 0;
+			std::size_t block = 0;  // next block to compress
+			std::size_t fullBlocks = 0;  // read straight from the message
+			std::size_t blockCount = 0;  // `fullBlocks` + the blocks in `tail`
+			Byte tail[BLOCK_SIZE * 2] = {};
+		};
+
+		const MD5 initial;
+		const std::size_t messageCount = static_cast<std::size_t>(messages.size());
+		std::size_t next = 0;
+
+		Lane lanes[Lanes];
+		uint32_t states[4][Lanes] = {};
+		const Byte *blocks[Lanes] = {};
+		const Byte idle[BLOCK_SIZE] = {};  // fed to the lanes without a message
+
+		const auto load = [&](const int j) -> bool
+		{
+			Lane &lane = lanes[j];
+			lane.busy = (next < messageCount);
+			if (!lane.busy)
+				return false;
+
+			const Span<const Byte> message = messages[next];
+			const std::size_t size = static_cast<std::size_t>(message.size());
+			lane.message = next++;
+			lane.block = 0;
+			lane.fullBlocks = size / BLOCK_SIZE;
+
+			// same paddings as `finalize()`
+			const std::size_t remain = size % BLOCK_SIZE;
+			const std::size_t tailSize = ((remain + 1 + 8) <= BLOCK_SIZE) ? BLOCK_SIZE : (BLOCK_SIZE * 2);
+			std::fill(lane.tail, (lane.tail + tailSize), 0);
+			std::copy((message.data() + (lane.fullBlocks * BLOCK_SIZE)), (message.data() + size), lane.tail);
+			lane.tail[remain] = (1 << 7);
+			const uint64_t sizeBits = static_cast<uint64_t>(size) * 8;
+			for (int i = 0; i < 8; ++i)
+				lane.tail[tailSize - 8 + i] = ror<Byte>(sizeBits, (8 * i));
+			lane.blockCount = lane.fullBlocks + (tailSize / BLOCK_SIZE);
+
+			for (int i = 0; i < 4; ++i)
+				states[i][j] = initial.m_state[i];
+			return true;
+		};
+		const auto blockOf = [&messages](const Lane &lane) -> const Byte*
+		{
+			if (lane.block < lane.fullBlocks)
+				return (messages[lane.message].data() + (lane.block * BLOCK_SIZE));
+			return (lane.tail + ((lane.block - lane.fullBlocks) * BLOCK_SIZE));
+		};
+
+		int busyLanes = 0;
+		for (int j = 0; j < Lanes; ++j)
+		{
+			if (load(j))
+				++busyLanes;
+		}
+
+		// a single remaining message is faster on the scalar code
+		while (busyLanes > 1)
+		{
+			for (int j = 0; j < Lanes; ++j)
+				blocks[j] = lanes[j].busy ? blockOf(lanes[j]) : idle;
+			compress(states, blocks);
+
+			for (int j = 0; j < Lanes; ++j)
+			{
+				Lane &lane = lanes[j];
+				if (!lane.busy)
+					continue;
+				if (++lane.block < lane.blockCount)
+					continue;
+
+				ResultArrayType &digest = digests[lane.message];
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int k = 0; k < 4; ++k)
+						digest[(4 * i) + k] = ror<Byte>(states[i][j], (8 * k));
+				}
+
+				if (!load(j))
+					--busyLanes;
+			}
+		}
+
+		for (int j = 0; j < Lanes; ++j)
+		{
+			Lane &lane = lanes[j];
+			if (!lane.busy)
+				continue;
+
+			MD5 hash;
+			for (int i = 0; i < 4; ++i)
+				hash.m_state[i] = states[i][j];
+			for (; lane.block < lane.blockCount; ++lane.block)
+				hash.addDataImpl({blockOf(lane), BLOCK_SIZE});
+			digests[lane.message] = hash.toArray();
+		}
+	}
+#endif
+
 	CONSTEXPR_CPP17_CHOCOBO1_HASH inline void MD5::addDataImpl(const Span<const Byte> data)
 	{
 		assert((data.size() % BLOCK_SIZE) == 0);
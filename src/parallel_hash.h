@@ -0,0 +1,374 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_PARALLEL_HASH_H
+#define CHOCOBO1_PARALLEL_HASH_H
+
+#include "cshake.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// ParallelHash_128(const int digestLengthInBytes, const int blockSizeInBytes, const std::string &customize = {});
+	// ParallelHash_256(const int digestLengthInBytes, const int blockSizeInBytes, const std::string &customize = {});
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+namespace Hash
+{
+#ifndef CHOCOBO1_HASH_ROR_IMPL
+#define CHOCOBO1_HASH_ROR_IMPL
+	template <typename R, typename T>
+	constexpr R ror(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<R>::value, "");
+		static_assert(std::is_unsigned<T>::value, "");
+		return static_cast<R>(x >> s);
+	}
+#endif
+
+
+namespace ParallelHash_NS
+{
+	template <typename Alg, typename Leaf, int L>
+	class ParallelHash
+	{
+		// https://doi.org/10.6028/NIST.SP.800-185
+		// every `blockSize` bytes of input is hashed on its own by `Leaf` (cSHAKE with empty N & S, which is SHAKE),
+		// the `L` bytes leaf digests are then hashed in order by `Alg`
+
+		public:
+			using Byte = uint8_t;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			ParallelHash(int digestLength, int blockSize, const std::string &customize = {});
+
+			void reset();
+			ParallelHash& finalize();  // after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			template <typename T>
+			operator T() const noexcept;
+
+			ParallelHash& addData(Span<const Byte> inData);  // large inputs hash the blocks on separate threads
+			ParallelHash& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			ParallelHash& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			ParallelHash& addData(const T (&array)[N]);
+			template <typename T>
+			ParallelHash& addData(Span<T> inSpan);
+
+			friend bool operator==(const ParallelHash &left, const ParallelHash &right)
+			{
+				return ((left.m_blockSize == right.m_blockSize)
+					&& (left.m_blockCount == right.m_blockCount)
+					&& (left.m_buffer == right.m_buffer)
+					&& (left.m_cshake == right.m_cshake));
+			}
+			friend bool operator!=(const ParallelHash &left, const ParallelHash &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller inputs aren't worth the threads
+			static constexpr std::size_t TASK_SIZE = 256 * 1024;  // a large input is handed to the workers in pieces of about this size
+
+			void addBlocks(Span<const Byte> data, bool parallel);
+			static void hashBlocks(Span<const Byte> data, int blockSize, Byte *digests);
+
+			Alg m_cshake;
+			int m_digestLength = 0;
+			int m_blockSize = 0;
+			std::string m_customize;
+
+			std::vector<Byte> m_buffer;  // incomplete block
+			uint64_t m_blockCount = 0;
+	};
+
+
+	// helpers
+	const auto rightEncode = [](const uint64_t value) -> Buffer<uint8_t, (sizeof(value) + 1)>
+	{
+		const uint8_t n = (value == 0) ? 1 : static_cast<uint8_t>(std::lround((std::log2(value) / 8) + 0.5));
+
+		Buffer<uint8_t, (sizeof(value) + 1)> ret;
+		for (int i = (n - 1); i >= 0; --i)
+			ret.fill(ror<uint8_t>(value, (8 * i)));
+		ret.fill(n);
+
+		return ret;
+	};
+
+
+	//
+	template <typename Alg, typename Leaf, int L>
+	ParallelHash<Alg, Leaf, L>::ParallelHash(const int digestLength, const int blockSize, const std::string &customize)
+		: m_cshake(digestLength, "ParallelHash", customize)
+		, m_digestLength(digestLength)
+		, m_blockSize(blockSize)
+		, m_customize(customize)
+	{
+		static_assert((L > 0), "Template parameter value invalid: L");
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		assert(blockSize > 0);
+
+		m_buffer.reserve(static_cast<std::size_t>(m_blockSize));
+
+		const auto encoded = Chocobo1::Hash::CShake_NS::leftEncode(static_cast<uint64_t>(m_blockSize));
+		m_cshake.addData({encoded.data(), encoded.size()});
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	void ParallelHash<Alg, Leaf, L>::reset()
+	{
+		m_cshake = Alg(m_digestLength, "ParallelHash", m_customize);
+		const auto encoded = Chocobo1::Hash::CShake_NS::leftEncode(static_cast<uint64_t>(m_blockSize));
+		m_cshake.addData({encoded.data(), encoded.size()});
+
+		m_buffer.clear();
+		m_blockCount = 0;
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::finalize()
+	{
+		if (!m_buffer.empty())
+		{
+			const auto digest = Leaf(L).addData(m_buffer).finalize().toVector();
+			m_cshake.addData(digest);
+			++m_blockCount;
+			m_buffer.clear();
+		}
+
+		const auto encodedCount = rightEncode(m_blockCount);
+		m_cshake.addData({encodedCount.data(), encodedCount.size()});
+		const auto encodedLength = rightEncode(static_cast<uint64_t>(m_digestLength) * 8);
+		m_cshake.addData({encodedLength.data(), encodedLength.size()});
+
+		m_cshake.finalize();
+		return (*this);
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	std::string ParallelHash<Alg, Leaf, L>::toString() const
+	{
+		return m_cshake.toString();
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	std::vector<typename ParallelHash<Alg, Leaf, L>::Byte> ParallelHash<Alg, Leaf, L>::toVector() const
+	{
+		return m_cshake.toVector();
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	template <typename T>
+	ParallelHash<Alg, Leaf, L>::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toVector();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::addData(const Span<const Byte> inData)
+	{
+		Span<const Byte> data = inData;
+		const std::size_t blockSize = static_cast<std::size_t>(m_blockSize);
+
+		// decided on the whole input, the aligned part is smaller and would miss the threshold with fixed size reads
+		const bool parallel = (static_cast<std::size_t>(inData.size()) >= MIN_PARALLEL_SIZE);
+
+		if (!m_buffer.empty())
+		{
+			const std::size_t len = std::min<std::size_t>((blockSize - m_buffer.size()), data.size());  // try fill to blockSize bytes
+			m_buffer.insert(m_buffer.end(), data.begin(), (data.begin() + len));
+
+			if (m_buffer.size() < blockSize)  // still doesn't fill the buffer
+				return (*this);
+
+			addBlocks(m_buffer, false);
+			m_buffer.clear();
+
+			data = data.subspan(len);
+		}
+
+		const std::size_t dataSize = data.size();
+		const std::size_t len = dataSize - (dataSize % blockSize);  // align on blockSize bytes
+		if (len > 0)
+			addBlocks(data.first(len), parallel);
+
+		if (len < dataSize)  // didn't consume all data
+			m_buffer.assign((data.begin() + len), data.end());
+
+		return (*this);
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	template <std::size_t N>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	template <typename T, std::size_t N>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	template <typename T>
+	ParallelHash<Alg, Leaf, L>& ParallelHash<Alg, Leaf, L>::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	void ParallelHash<Alg, Leaf, L>::addBlocks(const Span<const Byte> data, const bool parallel)
+	{
+		// `data` holds whole blocks only, their digests are absorbed in order
+		const std::size_t blockSize = static_cast<std::size_t>(m_blockSize);
+		const std::size_t blocks = static_cast<std::size_t>(data.size()) / blockSize;
+
+		std::vector<Byte> digests(blocks * L);
+
+		const std::size_t tasks = parallel
+			? std::min(blocks, std::max<std::size_t>((static_cast<std::size_t>(data.size()) / TASK_SIZE), 1))
+			: 1;
+		threadPool().parallelFor(tasks, [&](const std::size_t i) -> void
+		{
+			const std::size_t first = (blocks * i) / tasks;
+			const std::size_t last = (blocks * (i + 1)) / tasks;
+			hashBlocks(data.subspan((first * blockSize), ((last - first) * blockSize)), m_blockSize, (digests.data() + (first * L)));
+		});
+
+		m_cshake.addData(digests);
+		m_blockCount += blocks;
+	}
+
+	template <typename Alg, typename Leaf, int L>
+	void ParallelHash<Alg, Leaf, L>::hashBlocks(const Span<const Byte> data, const int blockSize, Byte *digests)
+	{
+		// `Leaf::hashBatch()` spreads the blocks over SIMD lanes when supported
+		std::vector<Span<const Byte>> blocks;
+		blocks.reserve(static_cast<std::size_t>(data.size()) / static_cast<std::size_t>(blockSize));
+		for (std::size_t i = 0; i < static_cast<std::size_t>(data.size()); i += static_cast<std::size_t>(blockSize))
+			blocks.emplace_back(data.subspan(i, static_cast<std::size_t>(blockSize)));
+
+		for (const auto &digest : Leaf::hashBatch(L, blocks))
+			digests = std::copy(digest.begin(), digest.end(), digests);
+	}
+}
+}
+
+	template <typename Base>
+	struct ParallelHashAlias : Base
+	{
+		using BaseType = Base;
+		explicit ParallelHashAlias(const int l, const int b, const std::string &c = {}) : Base(l, b, c) {}
+		ParallelHashAlias(const Base &other) : Base(other) {}
+		ParallelHashAlias(Base &&other) noexcept : Base(std::move(other)) {}
+		ParallelHashAlias& operator=(const Base &other) { if (this != &other) { Base::operator=(other); } return *this; }
+		ParallelHashAlias& operator=(Base &&other) noexcept { if (this != &other) { Base::operator=(std::move(other)); } return *this; }
+	};
+	using ParallelHash_128 = ParallelHashAlias<Hash::ParallelHash_NS::ParallelHash<CSHAKE_128, Hash::SHA3_NS::Keccak<(1344 / 8), 0x1F>, (256 / 8)>>;
+	using ParallelHash_256 = ParallelHashAlias<Hash::ParallelHash_NS::ParallelHash<CSHAKE_256, Hash::SHA3_NS::Keccak<(1088 / 8), 0x1F>, (512 / 8)>>;
+}
+
+namespace std
+{
+	template <typename Alg, typename Leaf, int L>
+	struct hash<Chocobo1::Hash::ParallelHash_NS::ParallelHash<Alg, Leaf, L>>
+	{
+		size_t operator()(const Chocobo1::Hash::ParallelHash_NS::ParallelHash<Alg, Leaf, L> &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::ParallelHash_128>
+	{
+		size_t operator()(const Chocobo1::ParallelHash_128 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::ParallelHash_256>
+	{
+		size_t operator()(const Chocobo1::ParallelHash_256 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_PARALLEL_HASH_H
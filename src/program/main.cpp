@@ -14,14 +14,23 @@
 #include "../blake1_384.h"
 #include "../blake1_512.h"
 #include "../blake2.h"
+#include "../blake2bp.h"
 #include "../blake2s.h"
+#include "../blake2sp.h"
+#include "../blake3.h"
+#include "../crc.h"
 #include "../crc_32.h"
+#include "../crc_32c.h"
 #include "../cshake.h"
+#include "../ed2k.h"
 #include "../fnv.h"
 #include "../has_160.h"
+#include "../kangaroo_twelve.h"
+#include "../kmac.h"
 #include "../md2.h"
 #include "../md4.h"
 #include "../md5.h"
+#include "../parallel_hash.h"
 #include "../ripemd_128.h"
 #include "../ripemd_160.h"
 #include "../ripemd_256.h"
@@ -37,17 +46,23 @@
 #include "../sha3.h"
 #include "../sm3.h"
 #include "../tiger.h"
+#include "../tth.h"
 #include "../tuple_hash.h"
 #include "../whirlpool.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+
 
 #define ARRAY_LENGTH(a) (static_cast<int>(std::extent<decltype(a)>::value))
 
@@ -55,14 +70,20 @@
 enum class Hash : int
 {
 	Blake1_224, Blake1_256, Blake1_384, Blake1_512,
-	Blake2, Blake2s,
-	Crc_32,
+	Blake2, Blake2bp, Blake2s, Blake2sp,
+	Blake3,
+	Crc_16, Crc_32, Crc_32_bzip2, Crc_32c, Crc_64_xz,
 	Cshake_128, Cshake_256,
+	Ed2k,
 	Fnv32_1a, Fnv64_1a,
+	Halfsiphash, Halfsiphash_64,
 	Has160,
+	Kangarootwelve,
+	Kmac_128, Kmac_256,
 	Md2, Md4, Md5,
+	Parallel_hash_128, Parallel_hash_256,
 	Ripemd_128, Ripemd_160, Ripemd_256, Ripemd_320,
-	Siphash,
+	Siphash, Siphash_1_3, Siphash_128,
 	Sha1,
 	Sha2_224, Sha2_256, Sha2_384, Sha2_512,
 	Sha2_512_224, Sha2_512_256,
@@ -71,7 +92,9 @@ enum class Hash : int
 	Sm3,
 	Tiger1_128, Tiger1_160, Tiger1_192,
 	Tiger2_128, Tiger2_160, Tiger2_192,
+	Tth,
 	Tuple_hash_128, Tuple_hash_256,
+	Turboshake_128, Turboshake_256,
 	Whirlpool,
 	Invalid,
 };
@@ -79,7 +102,9 @@ enum class Hash : int
 
 static void printUsage(const std::string &name);
 static Hash getHash(const std::string &hash);
-static bool runHash(const Hash hash, const int argc, const char *argv[]);
+static int runHash(const Hash hash, const int argc, const char *argv[]);  // returns the exit status, or `BAD_ARGUMENTS`
+
+static const int BAD_ARGUMENTS = -1;
 
 
 int main(const int argc, const char *argv[])
@@ -97,10 +122,10 @@ int main(const int argc, const char *argv[])
 
 	const Hash hash = getHash(argv[1]);
 
-	const bool ret = runHash(hash, argc, argv);
-	goToFail(!ret);
+	const int ret = runHash(hash, argc, argv);
+	goToFail(ret == BAD_ARGUMENTS);
 
-	return 0;
+	return ret;
 }
 
 void printUsage(const std::string &name)
@@ -111,15 +136,23 @@ void printUsage(const std::string &name)
 		"\n"
 		"Available HASH:\n"
 		"  -blake1-224"		"\t -blake1-256"	"\t -blake1-384"	"\t -blake1-512\n"
-		"  -blake2"			"\t -blake2s\n"
-		"  -crc-32\n"
+		"  -blake2"			"\t -blake2bp"		"\t -blake2s"		"\t -blake2sp\n"
+		"  -blake3 <Digest length (bytes)>\n"
+		"  -crc-16"		"\t -crc-32"		"\t -crc-32-bzip2"	"\t -crc-32c"		"\t -crc-64-xz\n"
 		"  -cshake-128 <Digest length (bytes)> <Customization string>\n"
 		"  -cshake-256 <Digest length (bytes)> <Customization string>\n"
+		"  -ed2k\n"
 		"  -fnv32_1a"		"\t -fnv64_1a\n"
+		"  -halfsiphash"	"\t -halfsiphash-64\n"
 		"  -has160\n"
+		"  -kangarootwelve <Digest length (bytes)> <Customization string>\n"
+		"  -kmac-128 <Digest length (bytes)> <Key> <Customization string>\n"
+		"  -kmac-256 <Digest length (bytes)> <Key> <Customization string>\n"
 		"  -md2"			"\t\t -md4"			"\t\t -md5\n"
+		"  -parallel-hash-128 <Digest length (bytes)> <Block size (bytes)> <Customization string>\n"
+		"  -parallel-hash-256 <Digest length (bytes)> <Block size (bytes)> <Customization string>\n"
 		"  -ripemd-128"		"\t -ripemd-160"	"\t -ripemd-256"	"\t -ripemd-320\n"
-		"  -siphash\n"
+		"  -siphash"		"\t -siphash-1-3"	"\t -siphash-128\n"
 		"  -sha1\n"
 		"  -sha2-224"		"\t -sha2-256"		"\t -sha2-384"		"\t -sha2-512"		"\t -sha2-512-224"	"\t -sha2-512-256\n"
 		"  -sha3-224"		"\t -sha3-256"		"\t -sha3-384"		"\t -sha3-512\n"
@@ -128,8 +161,11 @@ void printUsage(const std::string &name)
 		"  -sm3\n"
 		"  -tiger1-128"		"\t -tiger1-160"	"\t -tiger1-192\n"
 		"  -tiger2-128"		"\t -tiger2-160"	"\t -tiger2-192\n"
+		"  -tth\n"
 		"  -tuple-hash-128 <Digest length (bytes)> <Customization string>\n"
 		"  -tuple-hash-256 <Digest length (bytes)> <Customization string>\n"
+		"  -turboshake-128 <Digest length (bytes)>\n"
+		"  -turboshake-256 <Digest length (bytes)>\n"
 		"  -whirlpool\n"
 	);
 }
@@ -138,14 +174,20 @@ Hash getHash(const std::string &hash)
 {
 	static const std::string names[] = {
 		"-blake1-224", "-blake1-256", "-blake1-384", "-blake1-512",
-		"-blake2", "-blake2s",
-		"-crc-32",
+		"-blake2", "-blake2bp", "-blake2s", "-blake2sp",
+		"-blake3",
+		"-crc-16", "-crc-32", "-crc-32-bzip2", "-crc-32c", "-crc-64-xz",
 		"-cshake-128", "-cshake-256",
+		"-ed2k",
 		"-fnv32_1a", "-fnv64_1a",
+		"-halfsiphash", "-halfsiphash-64",
 		"-has160",
+		"-kangarootwelve",
+		"-kmac-128", "-kmac-256",
 		"-md2", "-md4", "-md5",
+		"-parallel-hash-128", "-parallel-hash-256",
 		"-ripemd-128", "-ripemd-160", "-ripemd-256", "-ripemd-320",
-		"-siphash",
+		"-siphash", "-siphash-1-3", "-siphash-128",
 		"-sha1",
 		"-sha2-224", "-sha2-256", "-sha2-384", "-sha2-512",
 		"-sha2-512-224", "-sha2-512-256",
@@ -154,7 +196,9 @@ Hash getHash(const std::string &hash)
 		"-sm3",
 		"-tiger1-128", "-tiger1-160", "-tiger1-192",
 		"-tiger2-128", "-tiger2-160", "-tiger2-192",
+		"-tth",
 		"-tuple-hash-128", "-tuple-hash-256",
+		"-turboshake-128", "-turboshake-256",
 		"-whirlpool"
 	};
 
@@ -166,7 +210,7 @@ Hash getHash(const std::string &hash)
 	return Hash::Invalid;
 }
 
-bool runHash(const Hash hash, const int argc, const char *argv[])
+int runHash(const Hash hash, const int argc, const char *argv[])
 {
 	const auto readNPrint = [](auto hash, const std::string &filename) -> void
 	{
@@ -209,76 +253,204 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 		printf("%s  %s\n", hash.nextData(buf.data(), buf.size()).finalize().toString().c_str(), filename.c_str());
 	};
 
+	const auto readElementNPrint = [&readAllNPrint](auto hash, const std::string &filename) -> int
+	{
+		// the file is streamed as 1 element, this needs its size up front
+		struct stat fileStat {};
+		if (filename != "-")
+		{
+			if (stat(filename.c_str(), &fileStat) != 0)
+			{
+				fprintf(stderr, "%s: %s\n", filename.c_str(), strerror(errno));
+				return EXIT_FAILURE;
+			}
+		}
+		if ((filename == "-") || ((fileStat.st_mode & S_IFMT) != S_IFREG))
+		{
+			readAllNPrint(hash, filename);
+			return EXIT_SUCCESS;
+		}
+
+		std::ifstream inStream(filename, (std::ios_base::in | std::ios_base::binary));
+		if (!inStream.is_open())
+		{
+			fprintf(stderr, "%s: %s\n", filename.c_str(), strerror(errno));
+			return EXIT_FAILURE;
+		}
+
+		const int bufSize = 1024 * 1024;
+		auto buf = std::make_unique<char[]>(bufSize);
+
+		uint64_t remaining = static_cast<uint64_t>(fileStat.st_size);
+		hash.beginElement(remaining);
+		while (inStream.good() && (remaining > 0))
+		{
+			inStream.read(buf.get(), static_cast<std::streamsize>(std::min<uint64_t>(bufSize, remaining)));
+			hash.addElementData(buf.get(), static_cast<std::size_t>(inStream.gcount()));
+			remaining -= static_cast<uint64_t>(inStream.gcount());
+		}
+
+		if (remaining > 0)
+		{
+			// the read stopped early, it is an error unless the file became shorter
+			struct stat nowStat {};
+			const bool shrank = (stat(filename.c_str(), &nowStat) == 0) && (nowStat.st_size < fileStat.st_size);
+			fprintf(stderr, "%s: %s\n", filename.c_str(), (shrank ? "file changed while reading" : "read error"));
+			return EXIT_FAILURE;
+		}
+		if (inStream.peek() != std::ifstream::traits_type::eof())
+		{
+			fprintf(stderr, "%s: file changed while reading\n", filename.c_str());
+			return EXIT_FAILURE;
+		}
+
+		printf("%s  %s\n", hash.endElement().finalize().toString().c_str(), filename.c_str());
+		return EXIT_SUCCESS;
+	};
+
 	// when benchmarking, comment out unrelated hash as it bloats the binary
 	switch (hash)
 	{
 		case Hash::Blake1_224:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake1_224(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Blake1_256:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake1_256(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Blake1_384:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake1_384(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Blake1_512:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake1_512(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Blake2:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake2(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Blake2bp:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::Blake2bp(), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Blake2s:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Blake2s(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Blake2sp:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::Blake2sp(), argv[2]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Blake3:
+		{
+			if (argc != 4)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			readNPrint(Chocobo1::Blake3(digestLength), argv[3]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Crc_16:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::CRC_16(), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Crc_32:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::CRC_32(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Crc_32_bzip2:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::CRC_32_BZIP2(), argv[2]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Crc_32c:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::CRC_32C(), argv[2]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Crc_64_xz:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::CRC_64_XZ(), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Cshake_128:
 		{
 			if (argc != 5)
-				return false;
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -287,17 +459,17 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
 			readNPrint(Chocobo1::CSHAKE_128(digestLength, argv[3]), argv[4]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Cshake_256:
 		{
 			if (argc != 5)
-				return false;
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -306,217 +478,375 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
 			readNPrint(Chocobo1::CSHAKE_256(digestLength, argv[3]), argv[4]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Ed2k:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::ED2K(), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Fnv32_1a:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::FNV32_1a(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Fnv64_1a:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::FNV64_1a(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Halfsiphash:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			// keep it simple for now
+			const unsigned char key[8] = {0};
+			readNPrint(Chocobo1::HalfSipHash(key), argv[2]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Halfsiphash_64:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			// keep it simple for now
+			const unsigned char key[8] = {0};
+			readNPrint(Chocobo1::HalfSipHash_64(key), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Has160:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::HAS_160(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Kangarootwelve:
+		{
+			if (argc != 5)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			readNPrint(Chocobo1::KangarooTwelve(digestLength, argv[3]), argv[4]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Kmac_128:
+		{
+			if (argc != 6)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			const std::string key = argv[3];
+			readNPrint(Chocobo1::KMAC_128(digestLength, {reinterpret_cast<const uint8_t*>(key.data()), key.size()}, argv[4]), argv[5]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Kmac_256:
+		{
+			if (argc != 6)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			const std::string key = argv[3];
+			readNPrint(Chocobo1::KMAC_256(digestLength, {reinterpret_cast<const uint8_t*>(key.data()), key.size()}, argv[4]), argv[5]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Md2:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::MD2(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Md4:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::MD4(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Md5:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::MD5(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Parallel_hash_128:
+		{
+			if (argc != 6)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			int blockSize = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+				blockSize = std::stoi(argv[3]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+			if (blockSize <= 0)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::ParallelHash_128(digestLength, blockSize, argv[4]), argv[5]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Parallel_hash_256:
+		{
+			if (argc != 6)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			int blockSize = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+				blockSize = std::stoi(argv[3]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+			if (blockSize <= 0)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::ParallelHash_256(digestLength, blockSize, argv[4]), argv[5]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Ripemd_128:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::RIPEMD_128(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Ripemd_160:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::RIPEMD_160(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Ripemd_256:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::RIPEMD_256(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Ripemd_320:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::RIPEMD_320(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Siphash:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			// keep it simple for now
 			const unsigned char key[16] = {0};
 			readNPrint(Chocobo1::SipHash(key), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Siphash_1_3:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			// keep it simple for now
+			const unsigned char key[16] = {0};
+			readNPrint(Chocobo1::SipHash_1_3(key), argv[2]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Siphash_128:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			// keep it simple for now
+			const unsigned char key[16] = {0};
+			readNPrint(Chocobo1::SipHash_128(key), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha1:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA1(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_224:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_224(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_256:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_256(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_384:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_384(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_512:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_512(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_512_224:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_512_224(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha2_512_256:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA2_512_256(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha3_224:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA3_224(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha3_256:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA3_256(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha3_384:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA3_384(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sha3_512:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SHA3_512(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Shake_128:
 		{
 			if (argc != 4)
-				return false;
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -525,17 +855,17 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
 			readNPrint(Chocobo1::SHAKE_128(digestLength), argv[3]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Shake_256:
 		{
 			if (argc != 4)
-				return false;
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -544,80 +874,89 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
 			readNPrint(Chocobo1::SHAKE_256(digestLength), argv[3]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Sm3:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::SM3(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger1_128:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger1_128(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger1_160:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger1_160(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger1_192:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger1_192(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger2_128:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger2_128(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger2_160:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger2_160(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tiger2_192:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Tiger2_192(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Tth:
+		{
+			if (argc != 3)
+				return BAD_ARGUMENTS;
+
+			readNPrint(Chocobo1::TTH(), argv[2]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Tuple_hash_128:
 		{
 			if (argc != 5)
-				return false;
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -626,17 +965,53 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
-			readAllNPrint(Chocobo1::TupleHash_128(digestLength, argv[3]), argv[4]);
-			return true;
+			return readElementNPrint(Chocobo1::TupleHash_128(digestLength, argv[3]), argv[4]);
 		}
 
 		case Hash::Tuple_hash_256:
 		{
 			if (argc != 5)
-				return false;
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			return readElementNPrint(Chocobo1::TupleHash_256(digestLength, argv[3]), argv[4]);
+		}
+
+		case Hash::Turboshake_128:
+		{
+			if (argc != 4)
+				return BAD_ARGUMENTS;
+
+			int digestLength = 0;
+			try
+			{
+				digestLength = std::stoi(argv[2]);
+			}
+			catch (const std::invalid_argument &e)
+			{
+				return BAD_ARGUMENTS;
+			}
+
+			readNPrint(Chocobo1::TurboSHAKE_128(digestLength), argv[3]);
+			return EXIT_SUCCESS;
+		}
+
+		case Hash::Turboshake_256:
+		{
+			if (argc != 4)
+				return BAD_ARGUMENTS;
 
 			int digestLength = 0;
 			try
@@ -645,26 +1020,26 @@ bool runHash(const Hash hash, const int argc, const char *argv[])
 			}
 			catch (const std::invalid_argument &e)
 			{
-				return false;
+				return BAD_ARGUMENTS;
 			}
 
-			readAllNPrint(Chocobo1::TupleHash_256(digestLength, argv[3]), argv[4]);
-			return true;
+			readNPrint(Chocobo1::TurboSHAKE_256(digestLength), argv[3]);
+			return EXIT_SUCCESS;
 		}
 
 		case Hash::Whirlpool:
 		{
 			if (argc != 3)
-				return false;
+				return BAD_ARGUMENTS;
 
 			readNPrint(Chocobo1::Whirlpool(), argv[2]);
-			return true;
+			return EXIT_SUCCESS;
 		}
 
 		default:
 		case Hash::Invalid:
-			return false;
+			return BAD_ARGUMENTS;
 	}
 
-	return false;
+	return BAD_ARGUMENTS;
 }
@@ -12,6 +12,8 @@
 #ifndef CHOCOBO1_SHA1_H
 #define CHOCOBO1_SHA1_H
 
+#include "x86_simd.h"
+
 #include <array>
 #include <cassert>
 #include <climits>
@@ -186,6 +188,162 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_SHA1_SHANI_IMPL
+#define CHOCOBO1_HASH_SHA1_SHANI_IMPL
+	X86_TARGET_CHOCOBO1_HASH("sha,sse4.1")
+	inline void sha1CompressShaNi(uint32_t (&state)[5], const uint8_t *data, const std::size_t blocks)
+	{
+		// `sha1rnds4` computes 4 rounds, `sha1nexte` derives E of the next 4 rounds from A
+		// message schedule: w[t] = rotl((w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16]), 1) is computed by `sha1msg1`, `xor` and `sha1msg2`
+
+		const __m128i byteSwapMask = _mm_set_epi64x(0x0001020304050607, 0x08090a0b0c0d0e0f);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0])), 0x1B);
+		__m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+		for (std::size_t i = 0; i < blocks; ++i)
+		{
+			const uint8_t *block = data + (i * 64);
+
+			const __m128i abcdSave = abcd;
+			const __m128i e0Save = e0;
+
+			__m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 0)), byteSwapMask);
+			__m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)), byteSwapMask);
+			__m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)), byteSwapMask);
+			__m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48)), byteSwapMask);
+
+			#ifdef sha1NiRounds
+			#error "macro name clash"
+			#else
+			#define sha1NiRounds(eIn, eOut, w, f) \
+				eIn = _mm_sha1nexte_epu32(eIn, w); \
+				eOut = abcd; \
+				abcd = _mm_sha1rnds4_epu32(abcd, eIn, f);
+
+			// rounds 0-3
+			e0 = _mm_add_epi32(e0, w0);
+			__m128i e1 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+			// rounds 4-7
+			sha1NiRounds(e1, e0, w1, 0);
+			w0 = _mm_sha1msg1_epu32(w0, w1);
+
+			// rounds 8-11
+			sha1NiRounds(e0, e1, w2, 0);
+			w1 = _mm_sha1msg1_epu32(w1, w2);
+			w0 = _mm_xor_si128(w0, w2);
+
+			// rounds 12-15
+			sha1NiRounds(e1, e0, w3, 0);
+			w0 = _mm_sha1msg2_epu32(w0, w3);
+			w2 = _mm_sha1msg1_epu32(w2, w3);
+			w1 = _mm_xor_si128(w1, w3);
+
+			// rounds 16-19
+			sha1NiRounds(e0, e1, w0, 0);
+			w1 = _mm_sha1msg2_epu32(w1, w0);
+			w3 = _mm_sha1msg1_epu32(w3, w0);
+			w2 = _mm_xor_si128(w2, w0);
+
+			// rounds 20-23
+			sha1NiRounds(e1, e0, w1, 1);
+			w2 = _mm_sha1msg2_epu32(w2, w1);
+			w0 = _mm_sha1msg1_epu32(w0, w1);
+			w3 = _mm_xor_si128(w3, w1);
+
+			// rounds 24-27
+			sha1NiRounds(e0, e1, w2, 1);
+			w3 = _mm_sha1msg2_epu32(w3, w2);
+			w1 = _mm_sha1msg1_epu32(w1, w2);
+			w0 = _mm_xor_si128(w0, w2);
+
+			// rounds 28-31
+			sha1NiRounds(e1, e0, w3, 1);
+			w0 = _mm_sha1msg2_epu32(w0, w3);
+			w2 = _mm_sha1msg1_epu32(w2, w3);
+			w1 = _mm_xor_si128(w1, w3);
+
+			// rounds 32-35
+			sha1NiRounds(e0, e1, w0, 1);
+			w1 = _mm_sha1msg2_epu32(w1, w0);
+			w3 = _mm_sha1msg1_epu32(w3, w0);
+			w2 = _mm_xor_si128(w2, w0);
+
+			// rounds 36-39
+			sha1NiRounds(e1, e0, w1, 1);
+			w2 = _mm_sha1msg2_epu32(w2, w1);
+			w0 = _mm_sha1msg1_epu32(w0, w1);
+			w3 = _mm_xor_si128(w3, w1);
+
+			// rounds 40-43
+			sha1NiRounds(e0, e1, w2, 2);
+			w3 = _mm_sha1msg2_epu32(w3, w2);
+			w1 = _mm_sha1msg1_epu32(w1, w2);
+			w0 = _mm_xor_si128(w0, w2);
+
+			// rounds 44-47
+			sha1NiRounds(e1, e0, w3, 2);
+			w0 = _mm_sha1msg2_epu32(w0, w3);
+			w2 = _mm_sha1msg1_epu32(w2, w3);
+			w1 = _mm_xor_si128(w1, w3);
+
+			// rounds 48-51
+			sha1NiRounds(e0, e1, w0, 2);
+			w1 = _mm_sha1msg2_epu32(w1, w0);
+			w3 = _mm_sha1msg1_epu32(w3, w0);
+			w2 = _mm_xor_si128(w2, w0);
+
+			// rounds 52-55
+			sha1NiRounds(e1, e0, w1, 2);
+			w2 = _mm_sha1msg2_epu32(w2, w1);
+			w0 = _mm_sha1msg1_epu32(w0, w1);
+			w3 = _mm_xor_si128(w3, w1);
+
+			// rounds 56-59
+			sha1NiRounds(e0, e1, w2, 2);
+			w3 = _mm_sha1msg2_epu32(w3, w2);
+			w1 = _mm_sha1msg1_epu32(w1, w2);
+			w0 = _mm_xor_si128(w0, w2);
+
+			// rounds 60-63
+			sha1NiRounds(e1, e0, w3, 3);
+			w0 = _mm_sha1msg2_epu32(w0, w3);
+			w2 = _mm_sha1msg1_epu32(w2, w3);
+			w1 = _mm_xor_si128(w1, w3);
+
+			// rounds 64-67
+			sha1NiRounds(e0, e1, w0, 3);
+			w1 = _mm_sha1msg2_epu32(w1, w0);
+			w3 = _mm_sha1msg1_epu32(w3, w0);
+			w2 = _mm_xor_si128(w2, w0);
+
+			// rounds 68-71
+			sha1NiRounds(e1, e0, w1, 3);
+			w2 = _mm_sha1msg2_epu32(w2, w1);
+			w3 = _mm_xor_si128(w3, w1);
+
+			// rounds 72-75
+			sha1NiRounds(e0, e1, w2, 3);
+			w3 = _mm_sha1msg2_epu32(w3, w2);
+
+			// rounds 76-79
+			sha1NiRounds(e1, e0, w3, 3);
+			#undef sha1NiRounds
+			#endif
+
+			abcd = _mm_add_epi32(abcd, abcdSave);
+			e0 = _mm_sha1nexte_epu32(e0, e0Save);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_shuffle_epi32(abcd, 0x1B));
+		state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+	}
+#endif
+#endif
+
 
 namespace SHA1_NS
 {
@@ -446,6 +604,14 @@ namespace SHA1_NS
 
 		m_sizeCounter += data.size();
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (!isConstantEvaluated() && cpuFeatures().sha && cpuFeatures().sse41)
+		{
+			sha1CompressShaNi(m_state, data.data(), static_cast<std::size_t>(data.size() / BLOCK_SIZE));
+			return;
+		}
+#endif
+
 		for (size_t i = 0, iend = static_cast<size_t>(data.size() / BLOCK_SIZE); i < iend; ++i)
 		{
 			const Loader<uint32_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
@@ -12,6 +12,8 @@
 #ifndef CHOCOBO1_SHA2_224_H
 #define CHOCOBO1_SHA2_224_H
 
+#include "x86_simd.h"
+
 #include <array>
 #include <cassert>
 #include <climits>
@@ -195,6 +197,107 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_SHA256_SHANI_IMPL
+#define CHOCOBO1_HASH_SHA256_SHANI_IMPL
+	X86_TARGET_CHOCOBO1_HASH("sha,sse4.1")
+	inline void sha256CompressShaNi(uint32_t (&state)[8], const uint8_t *data, const std::size_t blocks)
+	{
+		// shared by SHA2_224 & SHA2_256
+		// message schedule & rounds are computed by the SHA extensions
+
+		alignas(16) static const uint32_t kTable[64] =
+		{
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+			0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+			0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+			0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+			0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+			0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+			0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+			0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+			0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+		// the instructions expect the state as {ABEF, CDGH}
+		const __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0]));
+		const __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4]));
+		const __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+		const __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+		__m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+		__m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+		for (std::size_t i = 0; i < blocks; ++i)
+		{
+			const uint8_t *block = data + (i * 64);
+
+			const __m128i abefSave = abef;
+			const __m128i cdghSave = cdgh;
+
+			__m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 0)), byteSwapMask);
+			__m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)), byteSwapMask);
+			__m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)), byteSwapMask);
+			__m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48)), byteSwapMask);
+
+			#ifdef sha256NiRounds
+			#error "macro name clash"
+			#else
+			#define sha256NiRounds(w, t) \
+				wk = _mm_add_epi32(w, _mm_load_si128(reinterpret_cast<const __m128i *>(&kTable[t]))); \
+				cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+				wk = _mm_shuffle_epi32(wk, 0x0E); \
+				abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+
+			#ifdef sha256NiSchedule
+			#error "macro name clash"
+			#else
+			/* w[t] = ssig1(w[t - 2]) + w[t - 7] + ssig0(w[t - 15]) + w[t - 16] */
+			#define sha256NiSchedule(w0, w1, w2, w3) \
+				w0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4)), w3);
+
+			__m128i wk;
+			sha256NiRounds(w0, 0);
+			sha256NiRounds(w1, 4);
+			sha256NiRounds(w2, 8);
+			sha256NiRounds(w3, 12);
+
+			for (int t = 16; t < 64; t += 16)
+			{
+				sha256NiSchedule(w0, w1, w2, w3);
+				sha256NiRounds(w0, (t + 0));
+				sha256NiSchedule(w1, w2, w3, w0);
+				sha256NiRounds(w1, (t + 4));
+				sha256NiSchedule(w2, w3, w0, w1);
+				sha256NiRounds(w2, (t + 8));
+				sha256NiSchedule(w3, w0, w1, w2);
+				sha256NiRounds(w3, (t + 12));
+			}
+			#undef sha256NiSchedule
+			#endif
+			#undef sha256NiRounds
+			#endif
+
+			abef = _mm_add_epi32(abef, abefSave);
+			cdgh = _mm_add_epi32(cdgh, cdghSave);
+		}
+
+		const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+		const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+	}
+#endif
+#endif
+
 
 namespace SHA2_224_NS
 {
@@ -478,6 +581,14 @@ namespace SHA2_224_NS
 
 		m_sizeCounter += data.size();
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (!isConstantEvaluated() && cpuFeatures().sha && cpuFeatures().sse41)
+		{
+			sha256CompressShaNi(m_h, data.data(), static_cast<std::size_t>(data.size() / BLOCK_SIZE));
+			return;
+		}
+#endif
+
 		for (size_t i = 0, iend = static_cast<size_t>(data.size() / BLOCK_SIZE); i < iend; ++i)
 		{
 			const Loader<uint32_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
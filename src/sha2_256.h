@@ -12,6 +12,8 @@
 #ifndef CHOCOBO1_SHA2_256_H
 #define CHOCOBO1_SHA2_256_H
 
+#include "x86_simd.h"
+
 #include <array>
 #include <cassert>
 #include <climits>
@@ -195,6 +197,232 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_SHA256_SHANI_IMPL
+#define CHOCOBO1_HASH_SHA256_SHANI_IMPL
+	X86_TARGET_CHOCOBO1_HASH("sha,sse4.1")
+	inline void sha256CompressShaNi(uint32_t (&state)[8], const uint8_t *data, const std::size_t blocks)
+	{
+		// shared by SHA2_224 & SHA2_256
+		// message schedule & rounds are computed by the SHA extensions
+
+		alignas(16) static const uint32_t kTable[64] =
+		{
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+			0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+			0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+			0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+			0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+			0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+			0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+			0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+			0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+		// the instructions expect the state as {ABEF, CDGH}
+		const __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0]));
+		const __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4]));
+		const __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+		const __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+		__m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+		__m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+		for (std::size_t i = 0; i < blocks; ++i)
+		{
+			const uint8_t *block = data + (i * 64);
+
+			const __m128i abefSave = abef;
+			const __m128i cdghSave = cdgh;
+
+			__m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 0)), byteSwapMask);
+			__m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)), byteSwapMask);
+			__m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)), byteSwapMask);
+			__m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48)), byteSwapMask);
+
+			#ifdef sha256NiRounds
+			#error "macro name clash"
+			#else
+			#define sha256NiRounds(w, t) \
+				wk = _mm_add_epi32(w, _mm_load_si128(reinterpret_cast<const __m128i *>(&kTable[t]))); \
+				cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+				wk = _mm_shuffle_epi32(wk, 0x0E); \
+				abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+
+			#ifdef sha256NiSchedule
+			#error "macro name clash"
+			#else
+			/* w[t] = ssig1(w[t - 2]) + w[t - 7] + ssig0(w[t - 15]) + w[t - 16] */
+			#define sha256NiSchedule(w0, w1, w2, w3) \
+				w0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4)), w3);
+
+			__m128i wk;
+			sha256NiRounds(w0, 0);
+			sha256NiRounds(w1, 4);
+			sha256NiRounds(w2, 8);
+			sha256NiRounds(w3, 12);
+
+			for (int t = 16; t < 64; t += 16)
+			{
+				sha256NiSchedule(w0, w1, w2, w3);
+				sha256NiRounds(w0, (t + 0));
+				sha256NiSchedule(w1, w2, w3, w0);
+				sha256NiRounds(w1, (t + 4));
+				sha256NiSchedule(w2, w3, w0, w1);
+				sha256NiRounds(w2, (t + 8));
+				sha256NiSchedule(w3, w0, w1, w2);
+				sha256NiRounds(w3, (t + 12));
+			}
+			#undef sha256NiSchedule
+			#endif
+			#undef sha256NiRounds
+			#endif
+
+			abef = _mm_add_epi32(abef, abefSave);
+			cdgh = _mm_add_epi32(cdgh, cdghSave);
+		}
+
+		const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+		const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+	}
+#endif
+#endif
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_SHA256_AVX2_IMPL
+#define CHOCOBO1_HASH_SHA256_AVX2_IMPL
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline __m256i sha256Avx2Rotr(const __m256i x, const int s)
+	{
+		return _mm256_or_si256(_mm256_srli_epi32(x, s), _mm256_slli_epi32(x, (32 - s)));
+	}
+
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline void sha256CompressAvx2x8(uint32_t (&state)[8][8], const uint8_t * const (&blocks)[8])
+	{
+		// compress 1 block of 8 independent messages, message `i` occupies the 32-bit lane `i`
+		// `state[j][i]` is the j-th state word of message `i`
+
+		alignas(32) static const uint32_t kTable[64] =
+		{
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+			0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+			0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+			0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+			0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+			0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+			0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+			0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+			0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		const __m256i byteSwapMask = _mm256_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203, 0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+		// load & transpose the message blocks so that `w[t]` holds word `t` of every message
+		__m256i w[16];
+		for (int half = 0; half < 2; ++half)
+		{
+			__m256i r[8];
+			for (int i = 0; i < 8; ++i)
+				r[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[i] + (half * 32))), byteSwapMask);
+
+			const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+			const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+			const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+			const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+			const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+			const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+			const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+			const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+			const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+			const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+			const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+			const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+			const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+			const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+			const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+			const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+			__m256i *out = &w[half * 8];
+			out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+			out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+			out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+			out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+			out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+			out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+			out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+			out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+		}
+
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[0]));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[1]));
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[2]));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[3]));
+		__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[4]));
+		__m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[5]));
+		__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[6]));
+		__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[7]));
+
+		for (int t = 0; t < 64; ++t)
+		{
+			if (t >= 16)
+			{
+				// w[t] = ssig1(w[t - 2]) + w[t - 7] + ssig0(w[t - 15]) + w[t - 16]
+				const __m256i w2 = w[(t - 2) % 16];
+				const __m256i w15 = w[(t - 15) % 16];
+				const __m256i ssig0 = _mm256_xor_si256(_mm256_xor_si256(sha256Avx2Rotr(w15, 7), sha256Avx2Rotr(w15, 18)), _mm256_srli_epi32(w15, 3));
+				const __m256i ssig1 = _mm256_xor_si256(_mm256_xor_si256(sha256Avx2Rotr(w2, 17), sha256Avx2Rotr(w2, 19)), _mm256_srli_epi32(w2, 10));
+				w[t % 16] = _mm256_add_epi32(_mm256_add_epi32(ssig1, w[(t - 7) % 16]), _mm256_add_epi32(ssig0, w[t % 16]));
+			}
+
+			const __m256i bsig0 = _mm256_xor_si256(_mm256_xor_si256(sha256Avx2Rotr(a, 2), sha256Avx2Rotr(a, 13)), sha256Avx2Rotr(a, 22));
+			const __m256i bsig1 = _mm256_xor_si256(_mm256_xor_si256(sha256Avx2Rotr(e, 6), sha256Avx2Rotr(e, 11)), sha256Avx2Rotr(e, 25));
+			const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, _mm256_xor_si256(f, g)), g);
+			const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+
+			const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, bsig1), _mm256_add_epi32(ch, w[t % 16])), _mm256_set1_epi32(static_cast<int>(kTable[t])));
+			const __m256i t2 = _mm256_add_epi32(bsig0, maj);
+
+			h = g;
+			g = f;
+			f = e;
+			e = _mm256_add_epi32(d, t1);
+			d = c;
+			c = b;
+			b = a;
+			a = _mm256_add_epi32(t1, t2);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[0]), _mm256_add_epi32(a, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[0]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[1]), _mm256_add_epi32(b, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[1]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[2]), _mm256_add_epi32(c, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[2]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[3]), _mm256_add_epi32(d, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[3]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[4]), _mm256_add_epi32(e, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[4]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[5]), _mm256_add_epi32(f, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[5]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[6]), _mm256_add_epi32(g, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[6]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(state[7]), _mm256_add_epi32(h, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[7]))));
+	}
+#endif
+#endif
+
 
 namespace SHA2_256_NS
 {
@@ -235,6 +463,11 @@ namespace SHA2_256_NS
 			template <typename T>
 			SHA2_256& addData(Span<T> inSpan);
 
+			// hash independent messages, `results[i]` is the digest of `messages[i]`
+			// same as `SHA2_256().addData(messages[i]).finalize().toArray()` but multiple messages are processed in parallel when possible
+			static void hashBatch(Span<const Span<const Byte>> messages, Span<ResultArrayType> results);
+			static std::vector<ResultArrayType> hashBatch(Span<const Span<const Byte>> messages);
+
 			friend constexpr bool operator==(const SHA2_256 &left, const SHA2_256 &right)
 			{
 				for (int i = 0; i < 8; ++i)
@@ -250,7 +483,11 @@ namespace SHA2_256_NS
 			}
 
 		private:
+			CONSTEXPR_CPP17_CHOCOBO1_HASH void addPadding();
 			CONSTEXPR_CPP17_CHOCOBO1_HASH void addDataImpl(Span<const Byte> data);
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+			static void hashBatchAvx2(Span<const Span<const Byte>> messages, Span<ResultArrayType> results);
+#endif
 
 			static constexpr int BLOCK_SIZE = 64;
 
@@ -332,6 +569,137 @@ namespace SHA2_256_NS
 	}
 
 	CONSTEXPR_CPP17_CHOCOBO1_HASH inline SHA2_256& SHA2_256::finalize()
+	{
+		addPadding();
+
+		addDataImpl({m_buffer.data(), m_buffer.size()});
+		m_buffer.clear();
+
+		return (*this);
+	}
+
+	inline void SHA2_256::hashBatch(const Span<const Span<const Byte>> messages, const Span<ResultArrayType> results)
+	{
+		assert(messages.size() == results.size());
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		// a single SHA extensions stream is faster than 8 AVX2 lanes
+		if (!cpuFeatures().sha && cpuFeatures().avx2)
+		{
+			hashBatchAvx2(messages, results);
+			return;
+		}
+#endif
+
+		for (size_t i = 0, iend = static_cast<size_t>(messages.size()); i < iend; ++i)
+			results[i] = SHA2_256().addData(messages[i]).finalize().toArray();
+	}
+
+	inline std::vector<SHA2_256::ResultArrayType> SHA2_256::hashBatch(const Span<const Span<const Byte>> messages)
+	{
+		std::vector<ResultArrayType> ret(static_cast<size_t>(messages.size()));
+		hashBatch(messages, ret);
+		return ret;
+	}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	inline void SHA2_256::hashBatchAvx2(const Span<const Span<const Byte>> messages, const Span<ResultArrayType> results)
+	{
+		// every lane hashes one message at a time and is refilled with the next message when done
+		// a lane first consumes the full blocks of the message directly, then the final blocks in `m_buffer` prepared by `addPadding()`
+
+		const int LANES = 8;
+
+		SHA2_256 hashers[LANES];
+		const Byte *blocks[LANES] = {};
+		size_t blocksLeft[LANES] = {};
+		bool isFinalBlocks[LANES] = {};
+		size_t messageIdx[LANES] = {};
+		alignas(32) uint32_t state[8][LANES] = {};
+
+		const Byte dummyBlock[BLOCK_SIZE] = {};  // for idle lanes
+		size_t nextMessage = 0;
+		int activeLanes = 0;
+
+		const auto fillLane = [&](const int lane) -> void
+		{
+			if (nextMessage >= static_cast<size_t>(messages.size()))
+			{
+				blocks[lane] = dummyBlock;
+				blocksLeft[lane] = 0;
+				return;
+			}
+
+			const Span<const Byte> message = messages[nextMessage];
+			messageIdx[lane] = nextMessage;
+			++nextMessage;
+			++activeLanes;
+
+			SHA2_256 &hasher = hashers[lane];
+			hasher.reset();
+
+			const size_t len = static_cast<size_t>(message.size()) - (static_cast<size_t>(message.size()) % BLOCK_SIZE);  // align on BLOCK_SIZE bytes
+			hasher.m_sizeCounter = len;
+			hasher.m_buffer = {(message.begin() + len), message.end()};
+			hasher.addPadding();
+
+			if (len > 0)
+			{
+				blocks[lane] = message.data();
+				blocksLeft[lane] = len / BLOCK_SIZE;
+				isFinalBlocks[lane] = false;
+			}
+			else
+			{
+				blocks[lane] = hasher.m_buffer.data();
+				blocksLeft[lane] = hasher.m_buffer.size() / BLOCK_SIZE;
+				isFinalBlocks[lane] = true;
+			}
+
+			for (int i = 0; i < 8; ++i)
+				state[i][lane] = hasher.m_h[i];
+		};
+
+		for (int lane = 0; lane < LANES; ++lane)
+			fillLane(lane);
+
+		while (activeLanes > 0)
+		{
+			sha256CompressAvx2x8(state, blocks);
+
+			for (int lane = 0; lane < LANES; ++lane)
+			{
+				if (blocksLeft[lane] == 0)  // idle
+					continue;
+
+				--blocksLeft[lane];
+				if (blocksLeft[lane] > 0)
+				{
+					blocks[lane] += BLOCK_SIZE;
+					continue;
+				}
+
+				SHA2_256 &hasher = hashers[lane];
+				if (!isFinalBlocks[lane])
+				{
+					blocks[lane] = hasher.m_buffer.data();
+					blocksLeft[lane] = hasher.m_buffer.size() / BLOCK_SIZE;
+					isFinalBlocks[lane] = true;
+					continue;
+				}
+
+				for (int i = 0; i < 8; ++i)
+					hasher.m_h[i] = state[i][lane];
+				results[messageIdx[lane]] = hasher.toArray();
+
+				--activeLanes;
+				fillLane(lane);
+			}
+		}
+	}
+#endif
+
+	CONSTEXPR_CPP17_CHOCOBO1_HASH inline void SHA2_256::addPadding()
 	{
 		m_sizeCounter += m_buffer.size();
 
@@ -351,11 +719,6 @@ namespace SHA2_256_NS
 			m_buffer[m_buffer.size() - 8 + i] = ror<Byte>(sizeCounterBitsH, (8 * (3 - i)));
 			m_buffer[m_buffer.size() - 4 + i] = ror<Byte>(sizeCounterBitsL, (8 * (3 - i)));
 		}
-
-		addDataImpl({m_buffer.data(), m_buffer.size()});
-		m_buffer.clear();
-
-		return (*this);
 	}
 
 	inline std::string SHA2_256::toString() const
@@ -478,6 +841,14 @@ namespace SHA2_256_NS
 
 		m_sizeCounter += data.size();
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (!isConstantEvaluated() && cpuFeatures().sha && cpuFeatures().sse41)
+		{
+			sha256CompressShaNi(m_h, data.data(), static_cast<std::size_t>(data.size() / BLOCK_SIZE));
+			return;
+		}
+#endif
+
 		for (size_t i = 0, iend = static_cast<size_t>(data.size() / BLOCK_SIZE); i < iend; ++i)
 		{
 			const Loader<uint32_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
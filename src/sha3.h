@@ -12,6 +12,9 @@
 #ifndef CHOCOBO1_SHA3_H
 #define CHOCOBO1_SHA3_H
 
+#include "x86_simd.h"
+
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
@@ -51,6 +54,9 @@ namespace Chocobo1
 
 	// SHAKE_128(const int digestLengthInBytes);
 	// SHAKE_256(const int digestLengthInBytes);
+
+	// TurboSHAKE_128(const int digestLengthInBytes);  // domain separation byte 0x1F
+	// TurboSHAKE_256(const int digestLengthInBytes);  // for other values use `Hash::SHA3_NS::Keccak<rate, D, 12>`
 }
 
 
@@ -192,10 +198,316 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_KECCAK_AVX2_IMPL
+#define CHOCOBO1_HASH_KECCAK_AVX2_IMPL
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	inline void keccakPermutationAvx2x4(uint64_t (&states)[25][4], const int rounds)
+	{
+		// Keccak-p[1600, rounds] on 4 independent states, `states[i][j]` is lane `i` of state `j`
+		// same structure as `keccakPermutation()`, each register holds the same lane of the 4 states
+
+		const uint64_t roundConstants[24] =
+		{
+			0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
+			0x8000000080008081, 0x8000000000008009, 0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+			0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+			0x000000000000800A, 0x800000008000000A, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+		};
+
+		__m256i Aba = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[0]));
+		__m256i Abe = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[1]));
+		__m256i Abi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[2]));
+		__m256i Abo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[3]));
+		__m256i Abu = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[4]));
+		__m256i Aga = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[5]));
+		__m256i Age = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[6]));
+		__m256i Agi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[7]));
+		__m256i Ago = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[8]));
+		__m256i Agu = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[9]));
+		__m256i Aka = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[10]));
+		__m256i Ake = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[11]));
+		__m256i Aki = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[12]));
+		__m256i Ako = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[13]));
+		__m256i Aku = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[14]));
+		__m256i Ama = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[15]));
+		__m256i Ame = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[16]));
+		__m256i Ami = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[17]));
+		__m256i Amo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[18]));
+		__m256i Amu = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[19]));
+		__m256i Asa = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[20]));
+		__m256i Ase = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[21]));
+		__m256i Asi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[22]));
+		__m256i Aso = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[23]));
+		__m256i Asu = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states[24]));
+		__m256i Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki,
+			Eko, Eku, Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+
+		#ifdef keccakAvx2Rotl
+		#error "macro name clash"
+		#else
+		#define keccakAvx2Rotl(x, s) _mm256_or_si256(_mm256_slli_epi64((x), (s)), _mm256_srli_epi64((x), (64 - (s))))
+
+		#ifdef keccakAvx2Round
+		#error "macro name clash"
+		#else
+		#define keccakAvx2Round(A, E, roundConstant) \
+		{ \
+			const __m256i Ca = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A##ba, A##ga), _mm256_xor_si256(A##ka, A##ma)), A##sa); \
+			const __m256i Ce = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A##be, A##ge), _mm256_xor_si256(A##ke, A##me)), A##se); \
+			const __m256i Ci = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A##bi, A##gi), _mm256_xor_si256(A##ki, A##mi)), A##si); \
+			const __m256i Co = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A##bo, A##go), _mm256_xor_si256(A##ko, A##mo)), A##so); \
+			const __m256i Cu = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A##bu, A##gu), _mm256_xor_si256(A##ku, A##mu)), A##su); \
+			const __m256i Da = _mm256_xor_si256(Cu, keccakAvx2Rotl(Ce, 1)); \
+			const __m256i De = _mm256_xor_si256(Ca, keccakAvx2Rotl(Ci, 1)); \
+			const __m256i Di = _mm256_xor_si256(Ce, keccakAvx2Rotl(Co, 1)); \
+			const __m256i Do = _mm256_xor_si256(Ci, keccakAvx2Rotl(Cu, 1)); \
+			const __m256i Du = _mm256_xor_si256(Co, keccakAvx2Rotl(Ca, 1)); \
+			const __m256i Bba = _mm256_xor_si256(A##ba, Da); \
+			const __m256i Bbe = keccakAvx2Rotl(_mm256_xor_si256(A##ge, De), 44); \
+			const __m256i Bbi = keccakAvx2Rotl(_mm256_xor_si256(A##ki, Di), 43); \
+			const __m256i Bbo = keccakAvx2Rotl(_mm256_xor_si256(A##mo, Do), 21); \
+			const __m256i Bbu = keccakAvx2Rotl(_mm256_xor_si256(A##su, Du), 14); \
+			E##ba = _mm256_xor_si256(_mm256_xor_si256(Bba, _mm256_andnot_si256(Bbe, Bbi)), _mm256_set1_epi64x(static_cast<long long>(roundConstant))); \
+			E##be = _mm256_xor_si256(Bbe, _mm256_andnot_si256(Bbi, Bbo)); \
+			E##bi = _mm256_xor_si256(Bbi, _mm256_andnot_si256(Bbo, Bbu)); \
+			E##bo = _mm256_xor_si256(Bbo, _mm256_andnot_si256(Bbu, Bba)); \
+			E##bu = _mm256_xor_si256(Bbu, _mm256_andnot_si256(Bba, Bbe)); \
+			const __m256i Bga = keccakAvx2Rotl(_mm256_xor_si256(A##bo, Do), 28); \
+			const __m256i Bge = keccakAvx2Rotl(_mm256_xor_si256(A##gu, Du), 20); \
+			const __m256i Bgi = keccakAvx2Rotl(_mm256_xor_si256(A##ka, Da), 3); \
+			const __m256i Bgo = keccakAvx2Rotl(_mm256_xor_si256(A##me, De), 45); \
+			const __m256i Bgu = keccakAvx2Rotl(_mm256_xor_si256(A##si, Di), 61); \
+			E##ga = _mm256_xor_si256(Bga, _mm256_andnot_si256(Bge, Bgi)); \
+			E##ge = _mm256_xor_si256(Bge, _mm256_andnot_si256(Bgi, Bgo)); \
+			E##gi = _mm256_xor_si256(Bgi, _mm256_andnot_si256(Bgo, Bgu)); \
+			E##go = _mm256_xor_si256(Bgo, _mm256_andnot_si256(Bgu, Bga)); \
+			E##gu = _mm256_xor_si256(Bgu, _mm256_andnot_si256(Bga, Bge)); \
+			const __m256i Bka = keccakAvx2Rotl(_mm256_xor_si256(A##be, De), 1); \
+			const __m256i Bke = keccakAvx2Rotl(_mm256_xor_si256(A##gi, Di), 6); \
+			const __m256i Bki = keccakAvx2Rotl(_mm256_xor_si256(A##ko, Do), 25); \
+			const __m256i Bko = keccakAvx2Rotl(_mm256_xor_si256(A##mu, Du), 8); \
+			const __m256i Bku = keccakAvx2Rotl(_mm256_xor_si256(A##sa, Da), 18); \
+			E##ka = _mm256_xor_si256(Bka, _mm256_andnot_si256(Bke, Bki)); \
+			E##ke = _mm256_xor_si256(Bke, _mm256_andnot_si256(Bki, Bko)); \
+			E##ki = _mm256_xor_si256(Bki, _mm256_andnot_si256(Bko, Bku)); \
+			E##ko = _mm256_xor_si256(Bko, _mm256_andnot_si256(Bku, Bka)); \
+			E##ku = _mm256_xor_si256(Bku, _mm256_andnot_si256(Bka, Bke)); \
+			const __m256i Bma = keccakAvx2Rotl(_mm256_xor_si256(A##bu, Du), 27); \
+			const __m256i Bme = keccakAvx2Rotl(_mm256_xor_si256(A##ga, Da), 36); \
+			const __m256i Bmi = keccakAvx2Rotl(_mm256_xor_si256(A##ke, De), 10); \
+			const __m256i Bmo = keccakAvx2Rotl(_mm256_xor_si256(A##mi, Di), 15); \
+			const __m256i Bmu = keccakAvx2Rotl(_mm256_xor_si256(A##so, Do), 56); \
+			E##ma = _mm256_xor_si256(Bma, _mm256_andnot_si256(Bme, Bmi)); \
+			E##me = _mm256_xor_si256(Bme, _mm256_andnot_si256(Bmi, Bmo)); \
+			E##mi = _mm256_xor_si256(Bmi, _mm256_andnot_si256(Bmo, Bmu)); \
+			E##mo = _mm256_xor_si256(Bmo, _mm256_andnot_si256(Bmu, Bma)); \
+			E##mu = _mm256_xor_si256(Bmu, _mm256_andnot_si256(Bma, Bme)); \
+			const __m256i Bsa = keccakAvx2Rotl(_mm256_xor_si256(A##bi, Di), 62); \
+			const __m256i Bse = keccakAvx2Rotl(_mm256_xor_si256(A##go, Do), 55); \
+			const __m256i Bsi = keccakAvx2Rotl(_mm256_xor_si256(A##ku, Du), 39); \
+			const __m256i Bso = keccakAvx2Rotl(_mm256_xor_si256(A##ma, Da), 41); \
+			const __m256i Bsu = keccakAvx2Rotl(_mm256_xor_si256(A##se, De), 2); \
+			E##sa = _mm256_xor_si256(Bsa, _mm256_andnot_si256(Bse, Bsi)); \
+			E##se = _mm256_xor_si256(Bse, _mm256_andnot_si256(Bsi, Bso)); \
+			E##si = _mm256_xor_si256(Bsi, _mm256_andnot_si256(Bso, Bsu)); \
+			E##so = _mm256_xor_si256(Bso, _mm256_andnot_si256(Bsu, Bsa)); \
+			E##su = _mm256_xor_si256(Bsu, _mm256_andnot_si256(Bsa, Bse)); \
+		}
+
+		for (int i = (24 - rounds); i < 24; i += 2)
+		{
+			keccakAvx2Round(A, E, roundConstants[i]);
+			keccakAvx2Round(E, A, roundConstants[i + 1]);
+		}
+		#undef keccakAvx2Round
+		#endif
+		#undef keccakAvx2Rotl
+		#endif
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[0]), Aba);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[1]), Abe);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[2]), Abi);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[3]), Abo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[4]), Abu);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[5]), Aga);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[6]), Age);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[7]), Agi);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[8]), Ago);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[9]), Agu);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[10]), Aka);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[11]), Ake);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[12]), Aki);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[13]), Ako);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[14]), Aku);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[15]), Ama);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[16]), Ame);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[17]), Ami);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[18]), Amo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[19]), Amu);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[20]), Asa);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[21]), Ase);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[22]), Asi);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[23]), Aso);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(states[24]), Asu);
+	}
+#endif
+#endif
+
 
 namespace SHA3_NS
 {
-	template<int R, int P>  // `R`: see m_params. `P`: suffix + padding
+	constexpr void keccakPermutation(uint64_t (&state)[25], const int rounds = 24)
+	{
+		// Keccak-p[1600, rounds], `rounds` is even and the last `rounds` rounds of Keccak-f[1600] are applied
+		// the state is indexed as [5 * y + x]
+		assert(((rounds % 2) == 0) && (rounds > 0) && (rounds <= 24));
+
+		constexpr uint64_t roundConstants[24] =
+		{
+			0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
+			0x8000000080008081, 0x8000000000008009, 0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+			0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+			0x000000000000800A, 0x800000008000000A, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+		};
+
+		uint64_t Aba = state[0];
+		uint64_t Abe = state[1];
+		uint64_t Abi = state[2];
+		uint64_t Abo = state[3];
+		uint64_t Abu = state[4];
+		uint64_t Aga = state[5];
+		uint64_t Age = state[6];
+		uint64_t Agi = state[7];
+		uint64_t Ago = state[8];
+		uint64_t Agu = state[9];
+		uint64_t Aka = state[10];
+		uint64_t Ake = state[11];
+		uint64_t Aki = state[12];
+		uint64_t Ako = state[13];
+		uint64_t Aku = state[14];
+		uint64_t Ama = state[15];
+		uint64_t Ame = state[16];
+		uint64_t Ami = state[17];
+		uint64_t Amo = state[18];
+		uint64_t Amu = state[19];
+		uint64_t Asa = state[20];
+		uint64_t Ase = state[21];
+		uint64_t Asi = state[22];
+		uint64_t Aso = state[23];
+		uint64_t Asu = state[24];
+		uint64_t Eba = 0, Ebe = 0, Ebi = 0, Ebo = 0, Ebu = 0, Ega = 0, Ege = 0, Egi = 0, Ego = 0, Egu = 0, Eka = 0, Eke = 0, Eki = 0,
+			Eko = 0, Eku = 0, Ema = 0, Eme = 0, Emi = 0, Emo = 0, Emu = 0, Esa = 0, Ese = 0, Esi = 0, Eso = 0, Esu = 0;
+
+	// https://keccak.team/files/Keccak-implementation-3.2.pdf, section 2.4
+	// lanes are named after their coordinates: the rows y = 0 ~ 4 are "b, g, k, m, s", the columns x = 0 ~ 4 are "a, e, i, o, u"
+	// one round: from the lanes prefixed `A` to the lanes prefixed `E`, rho and pi are folded into the indexing
+	#ifdef keccakRound
+	#error "macro name clash"
+	#else
+	#define keccakRound(A, E, roundConstant) \
+	{ \
+		const uint64_t Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+		const uint64_t Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+		const uint64_t Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+		const uint64_t Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+		const uint64_t Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+		const uint64_t Da = Cu ^ rotl(Ce, 1); \
+		const uint64_t De = Ca ^ rotl(Ci, 1); \
+		const uint64_t Di = Ce ^ rotl(Co, 1); \
+		const uint64_t Do = Ci ^ rotl(Cu, 1); \
+		const uint64_t Du = Co ^ rotl(Ca, 1); \
+		const uint64_t Bba = (A##ba ^ Da); \
+		const uint64_t Bbe = rotl((A##ge ^ De), 44); \
+		const uint64_t Bbi = rotl((A##ki ^ Di), 43); \
+		const uint64_t Bbo = rotl((A##mo ^ Do), 21); \
+		const uint64_t Bbu = rotl((A##su ^ Du), 14); \
+		E##ba = Bba ^ ((~Bbe) & Bbi) ^ (roundConstant); \
+		E##be = Bbe ^ ((~Bbi) & Bbo); \
+		E##bi = Bbi ^ ((~Bbo) & Bbu); \
+		E##bo = Bbo ^ ((~Bbu) & Bba); \
+		E##bu = Bbu ^ ((~Bba) & Bbe); \
+		const uint64_t Bga = rotl((A##bo ^ Do), 28); \
+		const uint64_t Bge = rotl((A##gu ^ Du), 20); \
+		const uint64_t Bgi = rotl((A##ka ^ Da), 3); \
+		const uint64_t Bgo = rotl((A##me ^ De), 45); \
+		const uint64_t Bgu = rotl((A##si ^ Di), 61); \
+		E##ga = Bga ^ ((~Bge) & Bgi); \
+		E##ge = Bge ^ ((~Bgi) & Bgo); \
+		E##gi = Bgi ^ ((~Bgo) & Bgu); \
+		E##go = Bgo ^ ((~Bgu) & Bga); \
+		E##gu = Bgu ^ ((~Bga) & Bge); \
+		const uint64_t Bka = rotl((A##be ^ De), 1); \
+		const uint64_t Bke = rotl((A##gi ^ Di), 6); \
+		const uint64_t Bki = rotl((A##ko ^ Do), 25); \
+		const uint64_t Bko = rotl((A##mu ^ Du), 8); \
+		const uint64_t Bku = rotl((A##sa ^ Da), 18); \
+		E##ka = Bka ^ ((~Bke) & Bki); \
+		E##ke = Bke ^ ((~Bki) & Bko); \
+		E##ki = Bki ^ ((~Bko) & Bku); \
+		E##ko = Bko ^ ((~Bku) & Bka); \
+		E##ku = Bku ^ ((~Bka) & Bke); \
+		const uint64_t Bma = rotl((A##bu ^ Du), 27); \
+		const uint64_t Bme = rotl((A##ga ^ Da), 36); \
+		const uint64_t Bmi = rotl((A##ke ^ De), 10); \
+		const uint64_t Bmo = rotl((A##mi ^ Di), 15); \
+		const uint64_t Bmu = rotl((A##so ^ Do), 56); \
+		E##ma = Bma ^ ((~Bme) & Bmi); \
+		E##me = Bme ^ ((~Bmi) & Bmo); \
+		E##mi = Bmi ^ ((~Bmo) & Bmu); \
+		E##mo = Bmo ^ ((~Bmu) & Bma); \
+		E##mu = Bmu ^ ((~Bma) & Bme); \
+		const uint64_t Bsa = rotl((A##bi ^ Di), 62); \
+		const uint64_t Bse = rotl((A##go ^ Do), 55); \
+		const uint64_t Bsi = rotl((A##ku ^ Du), 39); \
+		const uint64_t Bso = rotl((A##ma ^ Da), 41); \
+		const uint64_t Bsu = rotl((A##se ^ De), 2); \
+		E##sa = Bsa ^ ((~Bse) & Bsi); \
+		E##se = Bse ^ ((~Bsi) & Bso); \
+		E##si = Bsi ^ ((~Bso) & Bsu); \
+		E##so = Bso ^ ((~Bsu) & Bsa); \
+		E##su = Bsu ^ ((~Bsa) & Bse); \
+	}
+
+
+		// 2 rounds per iteration so the lanes swap back and forth between `A` and `E` without copying
+		for (int i = (24 - rounds); i < 24; i += 2)
+		{
+			keccakRound(A, E, roundConstants[i]);
+			keccakRound(E, A, roundConstants[i + 1]);
+		}
+		#undef keccakRound
+		#endif
+
+		state[0] = Aba;
+		state[1] = Abe;
+		state[2] = Abi;
+		state[3] = Abo;
+		state[4] = Abu;
+		state[5] = Aga;
+		state[6] = Age;
+		state[7] = Agi;
+		state[8] = Ago;
+		state[9] = Agu;
+		state[10] = Aka;
+		state[11] = Ake;
+		state[12] = Aki;
+		state[13] = Ako;
+		state[14] = Aku;
+		state[15] = Ama;
+		state[16] = Ame;
+		state[17] = Ami;
+		state[18] = Amo;
+		state[19] = Amu;
+		state[20] = Asa;
+		state[21] = Ase;
+		state[22] = Asi;
+		state[23] = Aso;
+		state[24] = Asu;
+	}
+
+
+	template<int R, int P, int Rounds = 24>  // `R`: see m_params. `P`: suffix + padding
 	class Keccak
 	{
 		// https://dx.doi.org/10.6028/NIST.FIPS.202
@@ -213,9 +525,12 @@ namespace SHA3_NS
 
 
 			constexpr explicit Keccak(int digestLength);
+			constexpr Keccak(int digestLength, Byte padding);  // `padding` replaces `P`, for functions that differ from this one only in the suffix
+			constexpr Keccak(const Keccak &absorbed, int digestLength);  // continue from what `absorbed` has taken in, with another digest length
 
 			constexpr void reset();
-			Keccak& finalize();  // after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
+			Keccak& finalize();  // after this, only `operator T()`, `reset()`, `squeeze()`, `toString()`, `toVector()` are available
+			Keccak& squeeze(Span<Byte> out);  // writes the next `out.size()` bytes of the output stream, can be called repeatedly
 
 			std::string toString() const;
 			std::vector<Byte> toVector() const;
@@ -231,15 +546,17 @@ namespace SHA3_NS
 			template <typename T>
 			Keccak& addData(Span<T> inSpan);
 
+			// hash independent messages, 4 at a time in SIMD lanes when supported, returns the digests in the same order
+			static std::vector<std::vector<Byte>> hashBatch(int digestLength, Span<const Span<const Byte>> messages);
+
 			friend constexpr bool operator==(const Keccak &left, const Keccak &right)
 			{
-				for (int y = 0; y < 5; ++y)
+				if (left.m_padding != right.m_padding)
+					return false;
+				for (int i = 0; i < 25; ++i)
 				{
-					for (int x = 0; x < 5; ++x)
-					{
-						if (left.m_state[y][x] != right.m_state[y][x])
-							return false;
-					}
+					if (left.m_state[i] != right.m_state[i])
+						return false;
 				}
 				return true;
 			}
@@ -250,7 +567,12 @@ namespace SHA3_NS
 
 		private:
 			constexpr void addDataImpl(Span<const Byte> data);
-			std::vector<typename Keccak::Byte> stateToVector() const;
+			constexpr void addPadding();
+			constexpr void squeezeImpl(Span<Byte> out);
+			void squeezeDigest();
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+			static void hashBatchAvx2(int digestLength, const Span<const Byte> (&messages)[4], std::vector<std::vector<Byte>> &digests);
+#endif
 
 			struct
 			{
@@ -265,11 +587,14 @@ namespace SHA3_NS
 				int w = 64;       // (b / 25)
 			} m_params;
 			int m_digestLength;
+			Byte m_padding = static_cast<Byte>(P);
 
 			Buffer<Byte, R> m_buffer;
 			std::vector<Byte> m_final;
 
-			uint64_t m_state[5][5] = {};  // [y][x]
+			uint64_t m_state[25] = {};  // [5 * y + x]
+			bool m_squeezing = false;
+			int m_squeezeOffset = 0;  // bytes of the current block already squeezed out
 	};
 
 
@@ -306,61 +631,71 @@ namespace SHA3_NS
 
 
 	//
-	template <int R, int P>
-	constexpr Keccak<R, P>::Keccak(const int digestLength)
+	template <int R, int P, int Rounds>
+	constexpr Keccak<R, P, Rounds>::Keccak(const int digestLength)
 		: m_params()
 		, m_digestLength(digestLength)
 	{
 		static_assert((R >= 0), "Template parameter value invalid: R");
 		static_assert((P >= 0), "Template parameter value invalid: P");
+		static_assert(((Rounds % 2) == 0) && (Rounds > 0) && (Rounds <= 24), "Template parameter value invalid: Rounds");
 		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
 
-		m_final.reserve(m_digestLength);
 		reset();
 	}
 
-	template <int R, int P>
-	constexpr void Keccak<R, P>::reset()
+	template <int R, int P, int Rounds>
+	constexpr Keccak<R, P, Rounds>::Keccak(const int digestLength, const Byte padding)
+		: Keccak(digestLength)
+	{
+		m_padding = padding;
+	}
+
+	template <int R, int P, int Rounds>
+	constexpr Keccak<R, P, Rounds>::Keccak(const Keccak &absorbed, const int digestLength)
+		: Keccak(absorbed)
+	{
+		m_digestLength = digestLength;
+	}
+
+	template <int R, int P, int Rounds>
+	constexpr void Keccak<R, P, Rounds>::reset()
 	{
 		m_buffer.clear();
 		m_final.clear();
 
-		for (int y = 0; y < 5; ++y)
-			for (int x = 0; x < 5; ++x)
-				m_state[y][x] = 0;
+		for (int i = 0; i < 25; ++i)
+			m_state[i] = 0;
+
+		m_squeezing = false;
+		m_squeezeOffset = 0;
 	}
 
-	template <int R, int P>
-	Keccak<R, P>& Keccak<R, P>::finalize()
+	template <int R, int P, int Rounds>
+	Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::finalize()
 	{
-		// add padding
-		// the padding is reversed due to "B.1 Conversion Functions - Algorithm 11: b2h(S)"
-		m_buffer.fill(P);
-
-		const auto len = static_cast<int>(((2 * R) - m_buffer.size()) % R);
-		m_buffer.fill(0, len);
-		m_buffer[m_buffer.size() - 1] |= (1 << 7);
+		if (!m_final.empty())  // already finalized
+			return (*this);
 
-		addDataImpl({m_buffer.data(), m_buffer.size()});
-		m_buffer.clear();
+		if (!m_squeezing)
+			addPadding();
 
-		// squish out
-		while (true)
-		{
-			const std::vector<Byte> state = stateToVector();
-			m_final.insert(m_final.end(), state.begin(), (state.begin() + R));
-			if (m_final.size() >= static_cast<size_t>(m_digestLength))
-				break;
+		squeezeDigest();
+		return (*this);
+	}
 
-			addDataImpl(std::array<Byte, R> {});
-		}
+	template <int R, int P, int Rounds>
+	Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::squeeze(const Span<Byte> out)
+	{
+		if (!m_squeezing)
+			addPadding();
 
-		m_final.resize(m_digestLength);
+		squeezeImpl(out);
 		return (*this);
 	}
 
-	template <int R, int P>
-	std::string Keccak<R, P>::toString() const
+	template <int R, int P, int Rounds>
+	std::string Keccak<R, P, Rounds>::toString() const
 	{
 		const auto v = toVector();
 		std::string ret;
@@ -379,15 +714,15 @@ namespace SHA3_NS
 		return ret;
 	}
 
-	template <int R, int P>
-	std::vector<typename Keccak<R, P>::Byte> Keccak<R, P>::toVector() const
+	template <int R, int P, int Rounds>
+	std::vector<typename Keccak<R, P, Rounds>::Byte> Keccak<R, P, Rounds>::toVector() const
 	{
 		return m_final;
 	}
 
-	template <int R, int P>
+	template <int R, int P, int Rounds>
 	template <typename T>
-	Keccak<R, P>::operator T() const noexcept
+	Keccak<R, P, Rounds>::operator T() const noexcept
 	{
 		static_assert(std::is_unsigned<T>::value, "");
 
@@ -401,8 +736,8 @@ namespace SHA3_NS
 		return ret;
 	}
 
-	template <int R, int P>
-	constexpr Keccak<R, P>& Keccak<R, P>::addData(const Span<const Byte> inData)
+	template <int R, int P, int Rounds>
+	constexpr Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::addData(const Span<const Byte> inData)
 	{
 		Span<const Byte> data = inData;
 
@@ -436,36 +771,36 @@ namespace SHA3_NS
 		return (*this);
 	}
 
-	template <int R, int P>
-	constexpr Keccak<R, P>& Keccak<R, P>::addData(const void *ptr, const std::size_t length)
+	template <int R, int P, int Rounds>
+	constexpr Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::addData(const void *ptr, const std::size_t length)
 	{
 		// Span::size_type = std::size_t
 		return addData({static_cast<const Byte*>(ptr), length});
 	}
 
-	template <int R, int P>
+	template <int R, int P, int Rounds>
 	template <std::size_t N>
-	constexpr Keccak<R, P>& Keccak<R, P>::addData(const Byte (&array)[N])
+	constexpr Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::addData(const Byte (&array)[N])
 	{
 		return addData({array, N});
 	}
 
-	template <int R, int P>
+	template <int R, int P, int Rounds>
 	template <typename T, std::size_t N>
-	Keccak<R, P>& Keccak<R, P>::addData(const T (&array)[N])
+	Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::addData(const T (&array)[N])
 	{
 		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
 	}
 
-	template <int R, int P>
+	template <int R, int P, int Rounds>
 	template <typename T>
-	Keccak<R, P>& Keccak<R, P>::addData(const Span<T> inSpan)
+	Keccak<R, P, Rounds>& Keccak<R, P, Rounds>::addData(const Span<T> inSpan)
 	{
 		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
 	}
 
-	template <int R, int P>
-	constexpr void Keccak<R, P>::addDataImpl(const Span<const Byte> data)
+	template <int R, int P, int Rounds>
+	constexpr void Keccak<R, P, Rounds>::addDataImpl(const Span<const Byte> data)
 	{
 		assert((data.size() % R) == 0);
 
@@ -473,130 +808,133 @@ namespace SHA3_NS
 		{
 			const Loader<uint64_t> m(static_cast<const Byte *>(data.data() + (iter * R)));
 			for (int i = 0; i < (R / 8); ++i)
+				m_state[i] ^= m[i];
+
+			keccakPermutation(m_state, Rounds);
+		}
+	}
+
+	template <int R, int P, int Rounds>
+	std::vector<std::vector<typename Keccak<R, P, Rounds>::Byte>> Keccak<R, P, Rounds>::hashBatch(const int digestLength, const Span<const Span<const Byte>> messages)
+	{
+		std::vector<std::vector<Byte>> ret;
+		ret.reserve(messages.size());
+
+		std::size_t i = 0;
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (cpuFeatures().avx2)
+		{
+			for (; (i + 4) <= static_cast<std::size_t>(messages.size()); i += 4)
 			{
- 				uint64_t *statePtr = reinterpret_cast<uint64_t *>(m_state);
- 				statePtr[i] ^= m[i];
+				const Span<const Byte> group[4] = {messages[i], messages[i + 1], messages[i + 2], messages[i + 3]};
+				hashBatchAvx2(digestLength, group, ret);
 			}
+		}
+#endif
+
+		for (; i < static_cast<std::size_t>(messages.size()); ++i)
+			ret.emplace_back(Keccak(digestLength).addData(messages[i]).finalize().toVector());
+
+		return ret;
+	}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	template <int R, int P, int Rounds>
+	void Keccak<R, P, Rounds>::hashBatchAvx2(const int digestLength, const Span<const Byte> (&messages)[4], std::vector<std::vector<Byte>> &digests)
+	{
+		// the blocks that all 4 messages have are absorbed in lockstep, then each message continues on its own
+
+		// the last block of each message, padded
+		Byte lastBlocks[4][R] = {};
+		std::size_t blockCounts[4] = {};
+		for (int j = 0; j < 4; ++j)
+		{
+			const std::size_t size = static_cast<std::size_t>(messages[j].size());
+			const std::size_t fullBlocks = size / R;
+			std::copy((messages[j].data() + (fullBlocks * R)), (messages[j].data() + size), lastBlocks[j]);
+			lastBlocks[j][size - (fullBlocks * R)] = P;
+			lastBlocks[j][R - 1] |= (1 << 7);
+			blockCounts[j] = fullBlocks + 1;
+		}
 
-			const auto roundFunction = [this](const int indexRound)
+		#ifdef keccakBlock
+		#error "macro name clash"
+		#else
+		#define keccakBlock(j, b) \
+			(((b) < (blockCounts[j] - 1)) ? (messages[j].data() + ((b) * R)) : lastBlocks[j])
+
+		uint64_t states[25][4] = {};
+		const std::size_t commonBlocks = *std::min_element(blockCounts, (blockCounts + 4));
+		for (std::size_t b = 0; b < commonBlocks; ++b)
+		{
+			for (int j = 0; j < 4; ++j)
 			{
-				const auto theta = [this]()
-				{
-					const uint64_t c[5] =
-					{
-						(m_state[0][0] ^ m_state[1][0] ^ m_state[2][0] ^ m_state[3][0] ^ m_state[4][0]),
-						(m_state[0][1] ^ m_state[1][1] ^ m_state[2][1] ^ m_state[3][1] ^ m_state[4][1]),
-						(m_state[0][2] ^ m_state[1][2] ^ m_state[2][2] ^ m_state[3][2] ^ m_state[4][2]),
-						(m_state[0][3] ^ m_state[1][3] ^ m_state[2][3] ^ m_state[3][3] ^ m_state[4][3]),
-						(m_state[0][4] ^ m_state[1][4] ^ m_state[2][4] ^ m_state[3][4] ^ m_state[4][4])
-					};
-					const uint64_t d[5] =
-					{
-						c[4] ^ rotl(c[1], 1),
-						c[0] ^ rotl(c[2], 1),
-						c[1] ^ rotl(c[3], 1),
-						c[2] ^ rotl(c[4], 1),
-						c[3] ^ rotl(c[0], 1)
-					};
-
-					for (int y = 0; y < 5; ++y)
-					{
-						m_state[y][0] ^= d[0];
-						m_state[y][1] ^= d[1];
-						m_state[y][2] ^= d[2];
-						m_state[y][3] ^= d[3];
-						m_state[y][4] ^= d[4];
-					}
-				};
-				const auto rhoPiChi = [this]()
-				{
-					// rho, pi combined
-					const uint64_t tmp[5][5] =
-					{
-						{
-							rotl(m_state[0][0], (  0 % m_params.w)),
-							rotl(m_state[1][1], (300 % m_params.w)),
-							rotl(m_state[2][2], (171 % m_params.w)),
-							rotl(m_state[3][3], ( 21 % m_params.w)),
-							rotl(m_state[4][4], ( 78 % m_params.w))
-						},
-						{
-							rotl(m_state[0][3], ( 28 % m_params.w)),
-							rotl(m_state[1][4], (276 % m_params.w)),
-							rotl(m_state[2][0], (  3 % m_params.w)),
-							rotl(m_state[3][1], ( 45 % m_params.w)),
-							rotl(m_state[4][2], (253 % m_params.w))
-						},
-						{
-							rotl(m_state[0][1], (  1 % m_params.w)),
-							rotl(m_state[1][2], (  6 % m_params.w)),
-							rotl(m_state[2][3], (153 % m_params.w)),
-							rotl(m_state[3][4], (136 % m_params.w)),
-							rotl(m_state[4][0], (210 % m_params.w))
-						},
-						{
-							rotl(m_state[0][4], ( 91 % m_params.w)),
-							rotl(m_state[1][0], ( 36 % m_params.w)),
-							rotl(m_state[2][1], ( 10 % m_params.w)),
-							rotl(m_state[3][2], ( 15 % m_params.w)),
-							rotl(m_state[4][3], (120 % m_params.w))
-						},
-						{
-							rotl(m_state[0][2], (190 % m_params.w)),
-							rotl(m_state[1][3], ( 55 % m_params.w)),
-							rotl(m_state[2][4], (231 % m_params.w)),
-							rotl(m_state[3][0], (105 % m_params.w)),
-							rotl(m_state[4][1], ( 66 % m_params.w))
-						}
-					};
-					// chi
-					for (int y = 0; y < 5; ++y)
-					{
-						m_state[y][0] = tmp[y][0] ^ ((~tmp[y][1]) & tmp[y][2]);
-						m_state[y][1] = tmp[y][1] ^ ((~tmp[y][2]) & tmp[y][3]);
-						m_state[y][2] = tmp[y][2] ^ ((~tmp[y][3]) & tmp[y][4]);
-						m_state[y][3] = tmp[y][3] ^ ((~tmp[y][4]) & tmp[y][0]);
-						m_state[y][4] = tmp[y][4] ^ ((~tmp[y][0]) & tmp[y][1]);
-					}
-				};
-				const auto iota = [this](const int indexRound)
-				{
-					static const uint64_t roundConstantTable[24] =
-					{
-						0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
-						0x8000000080008081, 0x8000000000008009, 0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
-						0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
-						0x000000000000800A, 0x800000008000000A, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
-					};
-
-					m_state[0][0] ^= roundConstantTable[indexRound];
-				};
-
-				theta();
-				rhoPiChi();
-				iota(indexRound);
-			};
-
-			for (int i = 0; i < 24; ++i)
-				roundFunction(i);
+				const Loader<uint64_t> m(keccakBlock(j, b));
+				for (int i = 0; i < (R / 8); ++i)
+					states[i][j] ^= m[i];
+			}
+			keccakPermutationAvx2x4(states, Rounds);
 		}
+
+		for (int j = 0; j < 4; ++j)
+		{
+			Keccak hash(digestLength);
+			for (int i = 0; i < 25; ++i)
+				hash.m_state[i] = states[i][j];
+			for (std::size_t b = commonBlocks; b < blockCounts[j]; ++b)
+				hash.addDataImpl({keccakBlock(j, b), R});
+			hash.m_squeezing = true;
+			hash.squeezeDigest();
+
+			digests.emplace_back(hash.toVector());
+		}
+		#undef keccakBlock
+		#endif
 	}
+#endif
 
-	template <int R, int P>
-	std::vector<typename Keccak<R, P>::Byte> Keccak<R, P>::stateToVector() const
+	template <int R, int P, int Rounds>
+	constexpr void Keccak<R, P, Rounds>::addPadding()
 	{
-		const Span<const uint64_t> state(reinterpret_cast<const uint64_t *>(m_state), 25);
-		const int dataSize = sizeof(typename decltype(state)::value_type);
+		// the padding is reversed due to "B.1 Conversion Functions - Algorithm 11: b2h(S)"
+		m_buffer.fill(m_padding);
+
+		const auto len = static_cast<int>(((2 * R) - m_buffer.size()) % R);
+		m_buffer.fill(0, len);
+		m_buffer[m_buffer.size() - 1] |= (1 << 7);
+
+		addDataImpl({m_buffer.data(), m_buffer.size()});
+		m_buffer.clear();
+
+		m_squeezing = true;
+		m_squeezeOffset = 0;
+	}
 
-		std::vector<Byte> ret;
-		ret.reserve(dataSize * state.size());
-		for (const auto i : state)
+	template <int R, int P, int Rounds>
+	constexpr void Keccak<R, P, Rounds>::squeezeImpl(const Span<Byte> out)
+	{
+		// copy straight out of the state lanes, the state is permuted only when more bytes are wanted
+		std::size_t written = 0;
+		while (written < static_cast<std::size_t>(out.size()))
 		{
-			for (int j = 0; j < dataSize; ++j)
-				ret.emplace_back(ror<Byte>(i, (j * 8)));
+			if (m_squeezeOffset == R)
+			{
+				keccakPermutation(m_state, Rounds);
+				m_squeezeOffset = 0;
+			}
+
+			const std::size_t len = std::min(static_cast<std::size_t>(R - m_squeezeOffset), (static_cast<std::size_t>(out.size()) - written));
+			for (std::size_t i = 0; i < len; ++i, ++m_squeezeOffset)
+				out[written + i] = ror<Byte>(m_state[m_squeezeOffset / 8], ((m_squeezeOffset % 8) * 8));
+			written += len;
 		}
+	}
 
-		return ret;
+	template <int R, int P, int Rounds>
+	void Keccak<R, P, Rounds>::squeezeDigest()
+	{
+		m_final.resize(m_digestLength);
+		squeezeImpl({m_final.data(), m_final.size()});
 	}
 }
 }
@@ -610,6 +948,7 @@ namespace SHA3_NS
 		KeccakAlias(Base &&other) noexcept : Base(std::move(other)) {}
 		KeccakAlias& operator=(const Base &other) { if (this != &other) { Base::operator=(other); } return *this; }
 		KeccakAlias& operator=(Base &&other) noexcept { if (this != &other) { Base::operator=(std::move(other)); } return *this; }
+		static std::vector<std::vector<typename Base::Byte>> hashBatch(const typename Base::template Span<const typename Base::template Span<const typename Base::Byte>> messages) { return Base::hashBatch(N, messages); }
 	};
 	using SHA3_224 = KeccakAlias<Hash::SHA3_NS::Keccak<(1152 / 8), 0x06>, (224 / 8)>;
 	using SHA3_256 = KeccakAlias<Hash::SHA3_NS::Keccak<(1088 / 8), 0x06>, (256 / 8)>;
@@ -628,14 +967,18 @@ namespace SHA3_NS
 	};
 	using SHAKE_128 = SHAKEAlias<Hash::SHA3_NS::Keccak<(1344 / 8), 0x1F>>;
 	using SHAKE_256 = SHAKEAlias<Hash::SHA3_NS::Keccak<(1088 / 8), 0x1F>>;
+
+	// https://www.rfc-editor.org/rfc/rfc9861, same sponge as SHAKE but with 12 rounds
+	using TurboSHAKE_128 = SHAKEAlias<Hash::SHA3_NS::Keccak<(1344 / 8), 0x1F, 12>>;
+	using TurboSHAKE_256 = SHAKEAlias<Hash::SHA3_NS::Keccak<(1088 / 8), 0x1F, 12>>;
 }
 
 namespace std
 {
-	template <int R, int P>
-	struct hash<Chocobo1::Hash::SHA3_NS::Keccak<R, P>>
+	template <int R, int P, int Rounds>
+	struct hash<Chocobo1::Hash::SHA3_NS::Keccak<R, P, Rounds>>
 	{
-		size_t operator()(const Chocobo1::Hash::SHA3_NS::Keccak<R, P> &hash) const noexcept
+		size_t operator()(const Chocobo1::Hash::SHA3_NS::Keccak<R, P, Rounds> &hash) const noexcept
 		{
 			return hash;
 		}
@@ -694,6 +1037,24 @@ namespace std
 			return hash;
 		}
 	};
+
+	template <>
+	struct hash<Chocobo1::TurboSHAKE_128>
+	{
+		size_t operator()(const Chocobo1::TurboSHAKE_128 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <>
+	struct hash<Chocobo1::TurboSHAKE_256>
+	{
+		size_t operator()(const Chocobo1::TurboSHAKE_256 &hash) const noexcept
+		{
+			return hash;
+		}
+	};
 }
 
 #endif  // CHOCOBO1_SHA3_H
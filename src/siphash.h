@@ -12,11 +12,15 @@
 #ifndef CHOCOBO1_SIPHASH_H
 #define CHOCOBO1_SIPHASH_H
 
+#include "x86_simd.h"
+
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <string>
 #include <type_traits>
@@ -44,7 +48,14 @@
 namespace Chocobo1
 {
 	// Use these!!
-	// SipHash(const Span<const Byte> key);
+	// SipHash(const Span<const Byte> key);  // SipHash-2-4
+	// SipHash_1_3(const Span<const Byte> key);
+	// SipHash_128(const Span<const Byte> key);  // SipHash-2-4 with 128-bit digest
+	// SipHash_1_3_128(const Span<const Byte> key);
+	// HalfSipHash(const Span<const Byte> key);  // HalfSipHash-2-4, 64-bit key
+	// HalfSipHash_1_3(const Span<const Byte> key);
+	// HalfSipHash_64(const Span<const Byte> key);  // HalfSipHash-2-4 with 64-bit digest
+	// HalfSipHash_1_3_64(const Span<const Byte> key);
 }
 
 
@@ -186,17 +197,139 @@ namespace Hash
 	}
 #endif
 
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#ifndef CHOCOBO1_HASH_SIPHASH_SIMD_IMPL
+#define CHOCOBO1_HASH_SIPHASH_SIMD_IMPL
+	inline uint64_t sipHashLaneWord(const uint8_t *data, const std::size_t size, const std::size_t idx)
+	{
+		// the `idx`-th message word, the last word holds the remaining bytes & the size
+		const std::size_t fullWords = size / 8;
+		if (idx < fullWords)
+		{
+			uint64_t ret = 0;
+			std::memcpy(&ret, (data + (8 * idx)), sizeof(ret));  // x86 is little-endian
+			return ret;
+		}
+		if (idx > fullWords)
+			return 0;
+
+		uint64_t ret = static_cast<uint64_t>(size) << 56;
+		for (std::size_t i = 0, iMax = (size % 8); i < iMax; ++i)
+			ret |= (static_cast<uint64_t>(data[(8 * fullWords) + i]) << (8 * i));
+		return ret;
+	}
+
+	template <int C, int D, int L>
+	X86_TARGET_CHOCOBO1_HASH("avx2")
+	void sipHashAvx2x4(const uint64_t (&key)[2], const uint8_t *const (&data)[4], const std::size_t (&sizes)[4], uint64_t (&results)[L / 8][4])
+	{
+		// 4 messages in lock-step, 1 per 64-bit lane. A lane is masked off after its last word,
+		// so messages of similar lengths waste the least work
+
+		long long words[4] = {};
+		for (int j = 0; j < 4; ++j)
+			words[j] = static_cast<long long>(sizes[j] / 8) + 1;
+		const long long minWords = *std::min_element(words, (words + 4));
+		const long long maxWords = *std::max_element(words, (words + 4));
+		const __m256i wordCounts = _mm256_set_epi64x(words[3], words[2], words[1], words[0]);
+
+		__m256i v0 = _mm256_set1_epi64x(static_cast<long long>(key[0] ^ 0x736f6d6570736575));
+		__m256i v1 = _mm256_set1_epi64x(static_cast<long long>(key[1] ^ 0x646f72616e646f6d ^ ((L == 16) ? 0xee : 0)));
+		__m256i v2 = _mm256_set1_epi64x(static_cast<long long>(key[0] ^ 0x6c7967656e657261));
+		__m256i v3 = _mm256_set1_epi64x(static_cast<long long>(key[1] ^ 0x7465646279746573));
+
+		#ifdef sipHashAvx2Rotl
+		#error "macro name clash"
+		#else
+		#define sipHashAvx2Rotl(x, s) _mm256_or_si256(_mm256_slli_epi64((x), (s)), _mm256_srli_epi64((x), (64 - (s))))
+
+		#ifdef sipHashAvx2Round
+		#error "macro name clash"
+		#else
+		// same as `SipHash::sipRound()`, rotating by 32 is a dword swap
+		#define sipHashAvx2Round() \
+			v0 = _mm256_add_epi64(v0, v1); \
+			v2 = _mm256_add_epi64(v2, v3); \
+			v1 = sipHashAvx2Rotl(v1, 13); \
+			v3 = sipHashAvx2Rotl(v3, 16); \
+			v1 = _mm256_xor_si256(v1, v0); \
+			v3 = _mm256_xor_si256(v3, v2); \
+			v0 = _mm256_shuffle_epi32(v0, 0xb1); \
+			v2 = _mm256_add_epi64(v2, v1); \
+			v0 = _mm256_add_epi64(v0, v3); \
+			v1 = sipHashAvx2Rotl(v1, 17); \
+			v3 = sipHashAvx2Rotl(v3, 21); \
+			v1 = _mm256_xor_si256(v1, v2); \
+			v3 = _mm256_xor_si256(v3, v0); \
+			v2 = _mm256_shuffle_epi32(v2, 0xb1)
+
+		for (long long i = 0; i < maxWords; ++i)
+		{
+			const auto idx = static_cast<std::size_t>(i);
+			const __m256i m = _mm256_set_epi64x(
+				static_cast<long long>(sipHashLaneWord(data[3], sizes[3], idx)),
+				static_cast<long long>(sipHashLaneWord(data[2], sizes[2], idx)),
+				static_cast<long long>(sipHashLaneWord(data[1], sizes[1], idx)),
+				static_cast<long long>(sipHashLaneWord(data[0], sizes[0], idx)));
+			const __m256i s0 = v0;
+			const __m256i s1 = v1;
+			const __m256i s2 = v2;
+			const __m256i s3 = v3;
+
+			v3 = _mm256_xor_si256(v3, m);
+			for (int c = 0; c < C; ++c)
+			{
+				sipHashAvx2Round();
+			}
+			v0 = _mm256_xor_si256(v0, m);
+
+			if (i >= minWords)
+			{
+				const __m256i active = _mm256_cmpgt_epi64(wordCounts, _mm256_set1_epi64x(i));
+				v0 = _mm256_blendv_epi8(s0, v0, active);
+				v1 = _mm256_blendv_epi8(s1, v1, active);
+				v2 = _mm256_blendv_epi8(s2, v2, active);
+				v3 = _mm256_blendv_epi8(s3, v3, active);
+			}
+		}
+
+		v2 = _mm256_xor_si256(v2, _mm256_set1_epi64x((L == 16) ? 0xee : 0xff));
+		for (int d = 0; d < D; ++d)
+		{
+			sipHashAvx2Round();
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(results[0]), _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3)));
+
+		if (L == 16)
+		{
+			v1 = _mm256_xor_si256(v1, _mm256_set1_epi64x(0xdd));
+			for (int d = 0; d < D; ++d)
+			{
+				sipHashAvx2Round();
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(results[(L / 8) - 1]), _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3)));
+		}
+
+		#undef sipHashAvx2Round
+		#endif
+		#undef sipHashAvx2Rotl
+		#endif
+	}
+#endif
+#endif
+
 
 namespace SIPHASH_NS
 {
-	template <int C, int D>  // <compression rounds, finalization rounds>
+	template <int C, int D, int L = 8>  // <compression rounds, finalization rounds, digest length in bytes: 8 or 16>
 	class SipHash
 	{
 		// https://github.com/veorq/SipHash
+		// the digest is the output of the reference implementation in reverse byte order, for both digest lengths
 
 		public:
 			using Byte = uint8_t;
-			using ResultArrayType = std::array<Byte, 8>;
+			using ResultArrayType = std::array<Byte, L>;
 
 #if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
 			template <typename T, std::size_t Extent = std::dynamic_extent>
@@ -209,6 +342,11 @@ namespace SIPHASH_NS
 
 			constexpr SipHash(Span<const Byte> key);
 
+			// one-shot hashing without the buffering of `addData()`, meant for short inputs such as hash table keys
+			static CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType hash(Span<const Byte> key, Span<const Byte> data);
+			// hash independent messages under the same key, 4 at a time in AVX2 lanes when supported, returns the digests in the same order
+			static std::vector<ResultArrayType> hashBatch(Span<const Byte> key, Span<const Span<const Byte>> messages);
+
 			constexpr void reset();
 			CONSTEXPR_CPP17_CHOCOBO1_HASH SipHash& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
 
@@ -242,8 +380,14 @@ namespace SIPHASH_NS
 			}
 
 		private:
+			static CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType hashImpl(const uint64_t (&key)[2], Span<const Byte> data);
 			constexpr void addDataImpl(Span<const Byte> data);
-			constexpr void sipRound();
+
+			static constexpr void initState(uint64_t (&state)[4], const uint64_t (&key)[2]);
+			static constexpr void compress(uint64_t (&state)[4], uint64_t m);
+			static constexpr void finish(uint64_t (&state)[4], uint64_t (&result)[L / 8]);
+			static constexpr void sipRound(uint64_t (&state)[4]);
+			static CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toBytes(const uint64_t (&result)[L / 8]);
 
 			static constexpr int BLOCK_SIZE = 8;
 
@@ -252,6 +396,83 @@ namespace SIPHASH_NS
 
 			uint64_t m_key[2] = {};
 			uint64_t m_state[4] = {};
+			uint64_t m_result[L / 8] = {};
+	};
+
+	template <int C, int D, int L = 4>  // <compression rounds, finalization rounds, digest length in bytes: 4 or 8>
+	class HalfSipHash
+	{
+		// https://github.com/veorq/SipHash
+		// SipHash on 32-bit words with a 64-bit key, for platforms where 64-bit arithmetic is slow
+		// the digest is the output of the reference implementation in reverse byte order, for both digest lengths
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = std::array<Byte, L>;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			constexpr HalfSipHash(Span<const Byte> key);
+
+			// one-shot hashing without the buffering of `addData()`, meant for short inputs such as hash table keys
+			static CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType hash(Span<const Byte> key, Span<const Byte> data);
+
+			constexpr void reset();
+			CONSTEXPR_CPP17_CHOCOBO1_HASH HalfSipHash& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toArray() const;
+			template <typename T>
+			CONSTEXPR_CPP17_CHOCOBO1_HASH operator T() const noexcept;
+
+			constexpr HalfSipHash& addData(Span<const Byte> inData);
+			constexpr HalfSipHash& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			constexpr HalfSipHash& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			HalfSipHash& addData(const T (&array)[N]);
+			template <typename T>
+			HalfSipHash& addData(Span<T> inSpan);
+
+			friend constexpr bool operator==(const HalfSipHash &left, const HalfSipHash &right)
+			{
+				for (int i = 0; i < 4; ++i)
+				{
+					if (left.m_state[i] != right.m_state[i])
+						return false;
+				}
+				return true;
+			}
+			friend constexpr bool operator!=(const HalfSipHash &left, const HalfSipHash &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			constexpr void addDataImpl(Span<const Byte> data);
+
+			static constexpr void initState(uint32_t (&state)[4], const uint32_t (&key)[2]);
+			static constexpr void compress(uint32_t (&state)[4], uint32_t m);
+			static constexpr void finish(uint32_t (&state)[4], uint32_t (&result)[L / 4]);
+			static constexpr void sipRound(uint32_t (&state)[4]);
+			static CONSTEXPR_CPP17_CHOCOBO1_HASH ResultArrayType toBytes(const uint32_t (&result)[L / 4]);
+
+			static constexpr int BLOCK_SIZE = 4;
+
+			Buffer<Byte, (BLOCK_SIZE * 2)> m_buffer;  // x2 for paddings
+			uint8_t m_sizeCounter = 0;
+
+			uint32_t m_key[2] = {};
+			uint32_t m_state[4] = {};
+			uint32_t m_result[L / 4] = {};
 	};
 
 
@@ -269,17 +490,16 @@ namespace SIPHASH_NS
 
 			constexpr T operator[](const IndexType idx) const
 			{
-				static_assert(std::is_same<T, uint64_t>::value, "");
+				static_assert(std::is_unsigned<T>::value, "");
 				// handle specific endianness here
 				const uint8_t *ptr = m_ptr + (sizeof(T) * idx);
-				return  ( (static_cast<T>(*(ptr + 0)) <<  0)
-						| (static_cast<T>(*(ptr + 1)) <<  8)
-						| (static_cast<T>(*(ptr + 2)) << 16)
-						| (static_cast<T>(*(ptr + 3)) << 24)
-						| (static_cast<T>(*(ptr + 4)) << 32)
-						| (static_cast<T>(*(ptr + 5)) << 40)
-						| (static_cast<T>(*(ptr + 6)) << 48)
-						| (static_cast<T>(*(ptr + 7)) << 56));
+				T ret = 0;
+				for (int i = (static_cast<int>(sizeof(T)) - 1); i >= 0; --i)
+				{
+					ret <<= 8;
+					ret |= *(ptr + i);
+				}
+				return ret;
 			}
 
 		private:
@@ -288,9 +508,10 @@ namespace SIPHASH_NS
 
 
 	//
-	template <int C, int D>
-	constexpr SipHash<C, D>::SipHash(const Span<const Byte> key)
+	template <int C, int D, int L>
+	constexpr SipHash<C, D, L>::SipHash(const Span<const Byte> key)
 	{
+		static_assert(((L == 8) || (L == 16)), "Template parameter value invalid: L");
 		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
 		assert(key.size() == 16);
 
@@ -301,20 +522,75 @@ namespace SIPHASH_NS
 		reset();
 	}
 
-	template <int C, int D>
-	constexpr void SipHash<C, D>::reset()
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename SipHash<C, D, L>::ResultArrayType SipHash<C, D, L>::hash(const Span<const Byte> key, const Span<const Byte> data)
+	{
+		static_assert(((L == 8) || (L == 16)), "Template parameter value invalid: L");
+		assert(key.size() == 16);
+
+		const Loader<uint64_t> keyView(key.data());
+		const uint64_t k[2] = {keyView[0], keyView[1]};
+		return hashImpl(k, data);
+	}
+
+	template <int C, int D, int L>
+	std::vector<typename SipHash<C, D, L>::ResultArrayType> SipHash<C, D, L>::hashBatch(const Span<const Byte> key, const Span<const Span<const Byte>> messages)
+	{
+		static_assert(((L == 8) || (L == 16)), "Template parameter value invalid: L");
+		assert(key.size() == 16);
+
+		const Loader<uint64_t> keyView(key.data());
+		const uint64_t k[2] = {keyView[0], keyView[1]};
+
+		const std::size_t messageCount = static_cast<std::size_t>(messages.size());
+		std::vector<ResultArrayType> ret(messageCount);
+		std::size_t i = 0;
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+		if (cpuFeatures().avx2)
+		{
+			for (; (i + 4) <= messageCount; i += 4)
+			{
+				const Byte *data[4] = {};
+				std::size_t sizes[4] = {};
+				for (int j = 0; j < 4; ++j)
+				{
+					data[j] = messages[i + j].data();
+					sizes[j] = static_cast<std::size_t>(messages[i + j].size());
+				}
+
+				uint64_t results[L / 8][4] = {};
+				sipHashAvx2x4<C, D, L>(k, data, sizes, results);
+
+				for (int j = 0; j < 4; ++j)
+				{
+					uint64_t result[L / 8] = {};
+					for (int h = 0; h < (L / 8); ++h)
+						result[h] = results[h][j];
+					ret[i + j] = toBytes(result);
+				}
+			}
+		}
+#endif
+
+		// the remaining messages
+		for (; i < messageCount; ++i)
+			ret[i] = hashImpl(k, messages[i]);
+
+		return ret;
+	}
+
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::reset()
 	{
 		m_buffer.clear();
 		m_sizeCounter = 0;
 
-		m_state[0] = m_key[0] ^ 0x736f6d6570736575;
-		m_state[1] = m_key[1] ^ 0x646f72616e646f6d;
-		m_state[2] = m_key[0] ^ 0x6c7967656e657261;
-		m_state[3] = m_key[1] ^ 0x7465646279746573;
+		initState(m_state, m_key);
 	}
 
-	template <int C, int D>
-	CONSTEXPR_CPP17_CHOCOBO1_HASH SipHash<C, D>& SipHash<C, D>::finalize()
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH SipHash<C, D, L>& SipHash<C, D, L>::finalize()
 	{
 		m_sizeCounter += static_cast<uint8_t>(m_buffer.size());
 
@@ -328,15 +604,13 @@ namespace SIPHASH_NS
 		addDataImpl({m_buffer.data(), m_buffer.size()});
 		m_buffer.clear();
 
-		m_state[2] ^= 0xff;
-		for (int d = 0; d < D; ++d)
-			sipRound();
+		finish(m_state, m_result);
 
 		return (*this);
 	}
 
-	template <int C, int D>
-	std::string SipHash<C, D>::toString() const
+	template <int C, int D, int L>
+	std::string SipHash<C, D, L>::toString() const
 	{
 		const auto digest = toArray();
 		std::string ret;
@@ -355,30 +629,322 @@ namespace SIPHASH_NS
 		return ret;
 	}
 
-	template <int C, int D>
-	std::vector<typename SipHash<C, D>::Byte> SipHash<C, D>::toVector() const
+	template <int C, int D, int L>
+	std::vector<typename SipHash<C, D, L>::Byte> SipHash<C, D, L>::toVector() const
 	{
 		const auto digest = toArray();
 		return {digest.begin(), digest.end()};
 	}
 
-	template <int C, int D>
-	CONSTEXPR_CPP17_CHOCOBO1_HASH typename SipHash<C, D>::ResultArrayType SipHash<C, D>::toArray() const
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename SipHash<C, D, L>::ResultArrayType SipHash<C, D, L>::toArray() const
+	{
+		return toBytes(m_result);
+	}
+
+	template <int C, int D, int L>
+	template <typename T>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH SipHash<C, D, L>::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		const auto digest = toArray();
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), digest.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= digest[i];
+		}
+		return ret;
+	}
+
+	template <int C, int D, int L>
+	constexpr SipHash<C, D, L>& SipHash<C, D, L>::addData(const Span<const Byte> inData)
+	{
+		Span<const Byte> data = inData;
+
+		if (!m_buffer.empty())
+		{
+			const size_t len = std::min<size_t>((BLOCK_SIZE - m_buffer.size()), data.size());  // try fill to BLOCK_SIZE bytes
+			m_buffer.push_back(data.begin(), (data.begin() + len));
+
+			if (m_buffer.size() < BLOCK_SIZE)  // still doesn't fill the buffer
+				return (*this);
+
+			addDataImpl({m_buffer.data(), m_buffer.size()});
+			m_buffer.clear();
+
+			data = data.subspan(len);
+		}
+
+		const size_t dataSize = data.size();
+		if (dataSize < BLOCK_SIZE)
+		{
+			m_buffer = {data.begin(), data.end()};
+			return (*this);
+		}
+
+		const size_t len = dataSize - (dataSize % BLOCK_SIZE);  // align on BLOCK_SIZE bytes
+		addDataImpl(data.first(len));
+
+		if (len < dataSize)  // didn't consume all data
+			m_buffer = {(data.begin() + len), data.end()};
+
+		return (*this);
+	}
+
+	template <int C, int D, int L>
+	constexpr SipHash<C, D, L>& SipHash<C, D, L>::addData(const void *ptr, const std::size_t length)
 	{
-		const uint64_t result = m_state[0] ^ m_state[1] ^ m_state[2] ^ m_state[3];
-		const int dataSize = sizeof(result);
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <int C, int D, int L>
+	template <std::size_t N>
+	constexpr SipHash<C, D, L>& SipHash<C, D, L>::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <int C, int D, int L>
+	template <typename T, std::size_t N>
+	SipHash<C, D, L>& SipHash<C, D, L>::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <int C, int D, int L>
+	template <typename T>
+	SipHash<C, D, L>& SipHash<C, D, L>::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename SipHash<C, D, L>::ResultArrayType SipHash<C, D, L>::hashImpl(const uint64_t (&key)[2], const Span<const Byte> data)
+	{
+		uint64_t state[4] = {};
+		initState(state, key);
+
+		const std::size_t dataSize = static_cast<std::size_t>(data.size());
+		const std::size_t fullBlocks = dataSize / BLOCK_SIZE;
+		for (std::size_t i = 0; i < fullBlocks; ++i)
+		{
+			const Loader<uint64_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
+			compress(state, m[0]);
+		}
+
+		// the last block holds the remaining bytes & the size, same as `finalize()`
+		uint64_t last = static_cast<uint64_t>(dataSize) << 56;
+		const Byte *tail = data.data() + (fullBlocks * BLOCK_SIZE);
+		for (std::size_t i = 0, iMax = (dataSize % BLOCK_SIZE); i < iMax; ++i)
+			last |= (static_cast<uint64_t>(tail[i]) << (8 * i));
+		compress(state, last);
+
+		uint64_t result[L / 8] = {};
+		finish(state, result);
+		return toBytes(result);
+	}
+
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::addDataImpl(const Span<const Byte> data)
+	{
+		assert((data.size() % BLOCK_SIZE) == 0);
+
+		m_sizeCounter += static_cast<uint8_t>(data.size());
+
+		for (size_t i = 0, iend = static_cast<size_t>(data.size() / BLOCK_SIZE); i < iend; ++i)
+		{
+			const Loader<uint64_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
+			compress(m_state, m[0]);
+		}
+	}
 
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::initState(uint64_t (&state)[4], const uint64_t (&key)[2])
+	{
+		state[0] = key[0] ^ 0x736f6d6570736575;
+		state[1] = key[1] ^ 0x646f72616e646f6d;
+		state[2] = key[0] ^ 0x6c7967656e657261;
+		state[3] = key[1] ^ 0x7465646279746573;
+
+		if (L == 16)
+			state[1] ^= 0xee;
+	}
+
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::compress(uint64_t (&state)[4], const uint64_t m)
+	{
+		state[3] ^= m;
+		for (int c = 0; c < C; ++c)
+			sipRound(state);
+		state[0] ^= m;
+	}
+
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::finish(uint64_t (&state)[4], uint64_t (&result)[L / 8])
+	{
+		state[2] ^= ((L == 16) ? 0xee : 0xff);
+		for (int d = 0; d < D; ++d)
+			sipRound(state);
+		result[0] = state[0] ^ state[1] ^ state[2] ^ state[3];
+
+		if (L == 16)
+		{
+			state[1] ^= 0xdd;
+			for (int d = 0; d < D; ++d)
+				sipRound(state);
+			result[(L / 8) - 1] = state[0] ^ state[1] ^ state[2] ^ state[3];
+		}
+	}
+
+	template <int C, int D, int L>
+	constexpr void SipHash<C, D, L>::sipRound(uint64_t (&state)[4])
+	{
+		state[0] += state[1];
+		state[2] += state[3];
+		state[1] = rotl(state[1], 13);
+		state[3] = rotl(state[3], 16);
+		state[1] ^= state[0];
+		state[3] ^= state[2];
+		state[0] = rotl(state[0], 32);
+		state[2] += state[1];
+		state[0] += state[3];
+		state[1] = rotl(state[1], 17);
+		state[3] = rotl(state[3], 21);
+		state[1] ^= state[2];
+		state[3] ^= state[0];
+		state[2] = rotl(state[2], 32);
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename SipHash<C, D, L>::ResultArrayType SipHash<C, D, L>::toBytes(const uint64_t (&result)[L / 8])
+	{
 		ResultArrayType ret {};
 		auto *retPtr = ret.data();
-		for (int j = (dataSize - 1); j >= 0; --j)
-			*(retPtr++) = ror<Byte>(result, (j * 8));
+		for (int i = ((L / 8) - 1); i >= 0; --i)
+		{
+			for (int j = 7; j >= 0; --j)
+				*(retPtr++) = ror<Byte>(result[i], (j * 8));
+		}
+
+		return ret;
+	}
+
+
+	//
+	template <int C, int D, int L>
+	constexpr HalfSipHash<C, D, L>::HalfSipHash(const Span<const Byte> key)
+	{
+		static_assert(((L == 4) || (L == 8)), "Template parameter value invalid: L");
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+		assert(key.size() == 8);
+
+		const Loader<uint32_t> keyView(key.data());
+		m_key[0] = keyView[0];
+		m_key[1] = keyView[1];
+
+		reset();
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename HalfSipHash<C, D, L>::ResultArrayType HalfSipHash<C, D, L>::hash(const Span<const Byte> key, const Span<const Byte> data)
+	{
+		static_assert(((L == 4) || (L == 8)), "Template parameter value invalid: L");
+		assert(key.size() == 8);
+
+		const Loader<uint32_t> keyView(key.data());
+		const uint32_t k[2] = {keyView[0], keyView[1]};
+
+		uint32_t state[4] = {};
+		initState(state, k);
+
+		const std::size_t dataSize = static_cast<std::size_t>(data.size());
+		const std::size_t fullBlocks = dataSize / BLOCK_SIZE;
+		for (std::size_t i = 0; i < fullBlocks; ++i)
+		{
+			const Loader<uint32_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
+			compress(state, m[0]);
+		}
+
+		// the last block holds the remaining bytes & the size, same as `finalize()`
+		uint32_t last = static_cast<uint32_t>(static_cast<uint8_t>(dataSize)) << 24;
+		const Byte *tail = data.data() + (fullBlocks * BLOCK_SIZE);
+		for (std::size_t i = 0, iMax = (dataSize % BLOCK_SIZE); i < iMax; ++i)
+			last |= (static_cast<uint32_t>(tail[i]) << (8 * i));
+		compress(state, last);
+
+		uint32_t result[L / 4] = {};
+		finish(state, result);
+		return toBytes(result);
+	}
+
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::reset()
+	{
+		m_buffer.clear();
+		m_sizeCounter = 0;
+
+		initState(m_state, m_key);
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::finalize()
+	{
+		m_sizeCounter += static_cast<uint8_t>(m_buffer.size());
+
+		// append paddings
+		const auto len = static_cast<int>(BLOCK_SIZE - 1 - m_buffer.size());
+		m_buffer.fill(0, len);
+
+		// append size
+		m_buffer.fill(m_sizeCounter, 1);
+
+		addDataImpl({m_buffer.data(), m_buffer.size()});
+		m_buffer.clear();
+
+		finish(m_state, m_result);
+
+		return (*this);
+	}
+
+	template <int C, int D, int L>
+	std::string HalfSipHash<C, D, L>::toString() const
+	{
+		const auto digest = toArray();
+		std::string ret;
+		ret.resize(2 * digest.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : digest)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
 
 		return ret;
 	}
 
-	template <int C, int D>
+	template <int C, int D, int L>
+	std::vector<typename HalfSipHash<C, D, L>::Byte> HalfSipHash<C, D, L>::toVector() const
+	{
+		const auto digest = toArray();
+		return {digest.begin(), digest.end()};
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename HalfSipHash<C, D, L>::ResultArrayType HalfSipHash<C, D, L>::toArray() const
+	{
+		return toBytes(m_result);
+	}
+
+	template <int C, int D, int L>
 	template <typename T>
-	CONSTEXPR_CPP17_CHOCOBO1_HASH SipHash<C, D>::operator T() const noexcept
+	CONSTEXPR_CPP17_CHOCOBO1_HASH HalfSipHash<C, D, L>::operator T() const noexcept
 	{
 		static_assert(std::is_unsigned<T>::value, "");
 
@@ -392,8 +958,8 @@ namespace SIPHASH_NS
 		return ret;
 	}
 
-	template <int C, int D>
-	constexpr SipHash<C, D>& SipHash<C, D>::addData(const Span<const Byte> inData)
+	template <int C, int D, int L>
+	constexpr HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::addData(const Span<const Byte> inData)
 	{
 		Span<const Byte> data = inData;
 
@@ -427,36 +993,36 @@ namespace SIPHASH_NS
 		return (*this);
 	}
 
-	template <int C, int D>
-	constexpr SipHash<C, D>& SipHash<C, D>::addData(const void *ptr, const std::size_t length)
+	template <int C, int D, int L>
+	constexpr HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::addData(const void *ptr, const std::size_t length)
 	{
 		// Span::size_type = std::size_t
 		return addData({static_cast<const Byte*>(ptr), length});
 	}
 
-	template <int C, int D>
+	template <int C, int D, int L>
 	template <std::size_t N>
-	constexpr SipHash<C, D>& SipHash<C, D>::addData(const Byte (&array)[N])
+	constexpr HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::addData(const Byte (&array)[N])
 	{
 		return addData({array, N});
 	}
 
-	template <int C, int D>
+	template <int C, int D, int L>
 	template <typename T, std::size_t N>
-	SipHash<C, D>& SipHash<C, D>::addData(const T (&array)[N])
+	HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::addData(const T (&array)[N])
 	{
 		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
 	}
 
-	template <int C, int D>
+	template <int C, int D, int L>
 	template <typename T>
-	SipHash<C, D>& SipHash<C, D>::addData(const Span<T> inSpan)
+	HalfSipHash<C, D, L>& HalfSipHash<C, D, L>::addData(const Span<T> inSpan)
 	{
 		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
 	}
 
-	template <int C, int D>
-	constexpr void SipHash<C, D>::addDataImpl(const Span<const Byte> data)
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::addDataImpl(const Span<const Byte> data)
 	{
 		assert((data.size() % BLOCK_SIZE) == 0);
 
@@ -464,45 +1030,109 @@ namespace SIPHASH_NS
 
 		for (size_t i = 0, iend = static_cast<size_t>(data.size() / BLOCK_SIZE); i < iend; ++i)
 		{
-			const Loader<uint64_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
+			const Loader<uint32_t> m(static_cast<const Byte *>(data.data() + (i * BLOCK_SIZE)));
+			compress(m_state, m[0]);
+		}
+	}
 
-			m_state[3] ^= m[0];
-			for (int c = 0; c < C; ++c)
-				sipRound();
-			m_state[0] ^= m[0];
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::initState(uint32_t (&state)[4], const uint32_t (&key)[2])
+	{
+		state[0] = key[0];
+		state[1] = key[1];
+		state[2] = key[0] ^ 0x6c796765;
+		state[3] = key[1] ^ 0x74656462;
+
+		if (L == 8)
+			state[1] ^= 0xee;
+	}
+
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::compress(uint32_t (&state)[4], const uint32_t m)
+	{
+		state[3] ^= m;
+		for (int c = 0; c < C; ++c)
+			sipRound(state);
+		state[0] ^= m;
+	}
+
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::finish(uint32_t (&state)[4], uint32_t (&result)[L / 4])
+	{
+		state[2] ^= ((L == 8) ? 0xee : 0xff);
+		for (int d = 0; d < D; ++d)
+			sipRound(state);
+		result[0] = state[1] ^ state[3];
+
+		if (L == 8)
+		{
+			state[1] ^= 0xdd;
+			for (int d = 0; d < D; ++d)
+				sipRound(state);
+			result[(L / 4) - 1] = state[1] ^ state[3];
 		}
 	}
 
-	template <int C, int D>
-	constexpr void SipHash<C, D>::sipRound()
-	{
-		m_state[0] += m_state[1];
-		m_state[2] += m_state[3];
-		m_state[1] = rotl(m_state[1], 13);
-		m_state[3] = rotl(m_state[3], 16);
-		m_state[1] ^= m_state[0];
-		m_state[3] ^= m_state[2];
-		m_state[0] = rotl(m_state[0], 32);
-		m_state[2] += m_state[1];
-		m_state[0] += m_state[3];
-		m_state[1] = rotl(m_state[1], 17);
-		m_state[3] = rotl(m_state[3], 21);
-		m_state[1] ^= m_state[2];
-		m_state[3] ^= m_state[0];
-		m_state[2] = rotl(m_state[2], 32);
+	template <int C, int D, int L>
+	constexpr void HalfSipHash<C, D, L>::sipRound(uint32_t (&state)[4])
+	{
+		state[0] += state[1];
+		state[1] = rotl(state[1], 5);
+		state[1] ^= state[0];
+		state[0] = rotl(state[0], 16);
+		state[2] += state[3];
+		state[3] = rotl(state[3], 8);
+		state[3] ^= state[2];
+		state[0] += state[3];
+		state[3] = rotl(state[3], 7);
+		state[3] ^= state[0];
+		state[2] += state[1];
+		state[1] = rotl(state[1], 13);
+		state[1] ^= state[2];
+		state[2] = rotl(state[2], 16);
+	}
+
+	template <int C, int D, int L>
+	CONSTEXPR_CPP17_CHOCOBO1_HASH typename HalfSipHash<C, D, L>::ResultArrayType HalfSipHash<C, D, L>::toBytes(const uint32_t (&result)[L / 4])
+	{
+		ResultArrayType ret {};
+		auto *retPtr = ret.data();
+		for (int i = ((L / 4) - 1); i >= 0; --i)
+		{
+			for (int j = 3; j >= 0; --j)
+				*(retPtr++) = ror<Byte>(result[i], (j * 8));
+		}
+
+		return ret;
 	}
 }
 }
 
 	using SipHash = Hash::SIPHASH_NS::SipHash<2, 4>;
+	using SipHash_1_3 = Hash::SIPHASH_NS::SipHash<1, 3>;
+	using SipHash_128 = Hash::SIPHASH_NS::SipHash<2, 4, 16>;
+	using SipHash_1_3_128 = Hash::SIPHASH_NS::SipHash<1, 3, 16>;
+	using HalfSipHash = Hash::SIPHASH_NS::HalfSipHash<2, 4>;
+	using HalfSipHash_1_3 = Hash::SIPHASH_NS::HalfSipHash<1, 3>;
+	using HalfSipHash_64 = Hash::SIPHASH_NS::HalfSipHash<2, 4, 8>;
+	using HalfSipHash_1_3_64 = Hash::SIPHASH_NS::HalfSipHash<1, 3, 8>;
 }
 
 namespace std
 {
-	template <int C, int D>
-	struct hash<Chocobo1::Hash::SIPHASH_NS::SipHash<C, D>>
+	template <int C, int D, int L>
+	struct hash<Chocobo1::Hash::SIPHASH_NS::SipHash<C, D, L>>
+	{
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Hash::SIPHASH_NS::SipHash<C, D, L> &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+
+	template <int C, int D, int L>
+	struct hash<Chocobo1::Hash::SIPHASH_NS::HalfSipHash<C, D, L>>
 	{
-		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Hash::SIPHASH_NS::SipHash<C, D> &hash) const noexcept
+		CONSTEXPR_CPP17_CHOCOBO1_HASH size_t operator()(const Chocobo1::Hash::SIPHASH_NS::HalfSipHash<C, D, L> &hash) const noexcept
 		{
 			return hash;
 		}
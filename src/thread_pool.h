@@ -0,0 +1,217 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_THREAD_POOL_H
+#define CHOCOBO1_THREAD_POOL_H
+
+// internal header: the persistent worker threads shared by the algorithms that hash large inputs in parallel
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+	class ThreadPool
+	{
+		// the workers are started once and wait for tasks, so splitting an input doesn't create threads every time
+		// the caller of `parallelFor()` runs tasks too while it waits, which also makes a pool without workers usable
+
+		public:
+			ThreadPool();
+			explicit ThreadPool(std::size_t workers);
+			~ThreadPool();
+
+			ThreadPool(const ThreadPool &) = delete;
+			ThreadPool& operator=(const ThreadPool &) = delete;
+
+			std::size_t workerCount() const;
+			uint64_t queuedTasksForTesting();  // total since start, lets tests check that an input was split
+
+			template <typename Func>
+			void parallelFor(std::size_t count, Func func);  // runs `func(0)` ... `func(count - 1)`, returns when all are done, then rethrows an exception of `func` if any
+
+		private:
+			void work();
+
+			std::mutex m_mutex;
+			std::condition_variable m_wake;  // a task was queued or the pool stops
+			std::condition_variable m_done;  // a task finished
+			std::deque<std::function<void()>> m_tasks;
+			uint64_t m_queuedTasks = 0;
+			bool m_stop = false;
+
+			std::vector<std::thread> m_workers;
+	};
+
+	inline ThreadPool& threadPool()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+
+	//
+	inline ThreadPool::ThreadPool()
+		: ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1)  // the caller is the remaining thread
+	{
+	}
+
+	inline ThreadPool::ThreadPool(const std::size_t workers)
+	{
+		m_workers.reserve(workers);
+		for (std::size_t i = 0; i < workers; ++i)
+			m_workers.emplace_back(&ThreadPool::work, this);
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+
+		for (auto &worker : m_workers)
+			worker.join();
+	}
+
+	inline std::size_t ThreadPool::workerCount() const
+	{
+		return m_workers.size();
+	}
+
+	inline uint64_t ThreadPool::queuedTasksForTesting()
+	{
+		const std::lock_guard<std::mutex> lock(m_mutex);
+		return m_queuedTasks;
+	}
+
+	template <typename Func>
+	void ThreadPool::parallelFor(const std::size_t count, Func func)
+	{
+		if (count == 0)
+			return;
+		if (count == 1)
+		{
+			func(std::size_t {0});
+			return;
+		}
+
+		// the tasks refer to this stack frame, so it is left only after all of them are done, also when one throws
+		std::size_t remaining = 0;  // of the queued tasks, guarded by `m_mutex`
+		std::exception_ptr taskError;  // the first exception of a queued task, guarded by `m_mutex`
+		std::size_t queued = 0;
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			try
+			{
+				for (std::size_t i = 1; i < count; ++i, ++queued)
+				{
+					m_tasks.emplace_back([this, &func, &remaining, &taskError, i]() -> void
+					{
+						std::exception_ptr error;
+						try
+						{
+							func(i);
+						}
+						catch (...)
+						{
+							error = std::current_exception();
+						}
+
+						const std::lock_guard<std::mutex> taskLock(m_mutex);
+						if (error && !taskError)
+							taskError = error;
+						if (--remaining == 0)
+							m_done.notify_all();
+					});
+				}
+			}
+			catch (...)
+			{
+				// out of memory while queuing, the calling thread runs the rest below
+			}
+			remaining = queued;
+			m_queuedTasks += queued;
+		}
+		m_wake.notify_all();
+
+		std::exception_ptr callerError;
+		try
+		{
+			func(std::size_t {0});
+			for (std::size_t i = (queued + 1); i < count; ++i)
+				func(i);
+		}
+		catch (...)
+		{
+			callerError = std::current_exception();
+		}
+
+		// help with the queue instead of idling, the tasks taken may belong to another caller
+		// the tasks don't throw, their exceptions are kept by the caller they belong to
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (remaining > 0)
+		{
+			if (m_tasks.empty())
+			{
+				m_done.wait(lock);
+				continue;
+			}
+
+			const std::function<void()> task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+
+			lock.unlock();
+			task();
+			lock.lock();
+		}
+		lock.unlock();
+
+		if (callerError)
+			std::rethrow_exception(callerError);
+		if (taskError)
+			std::rethrow_exception(taskError);
+	}
+
+	inline void ThreadPool::work()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_wake.wait(lock, [this]() { return (m_stop || !m_tasks.empty()); });
+			if (m_tasks.empty())  // `m_stop`
+				return;
+
+			const std::function<void()> task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+
+			lock.unlock();
+			task();
+			lock.lock();
+		}
+	}
+}
+}
+
+#endif  // CHOCOBO1_THREAD_POOL_H
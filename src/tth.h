@@ -0,0 +1,385 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_TTH_H
+#define CHOCOBO1_TTH_H
+
+#include "thread_pool.h"
+#include "tiger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if (__cplusplus > 201703L)
+#include <version>
+#endif
+
+#ifndef USE_STD_SPAN_CHOCOBO1_HASH
+#if (__cpp_lib_span >= 202002L)
+#define USE_STD_SPAN_CHOCOBO1_HASH 1
+#else
+#define USE_STD_SPAN_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+#include <span>
+#else
+#include "gsl/span"
+#endif
+
+
+namespace Chocobo1
+{
+	// Use these!!
+	// TTH(const int exportLevel = -1);
+}
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+namespace TTH_NS
+{
+	class TTH
+	{
+		// Tiger Tree Hash, https://adc.sourceforge.io/draft-jchapweske-thex-02.html
+		// leaf = Tiger(0x00 || 1024 bytes of data), node = Tiger(0x01 || left || right), a node without a sibling is promoted
+		// to the level above. Only the roots of the complete subtrees are kept while data is added, 1 per level.
+		//
+		// `exportLevel` >= 0 keeps the nodes of that level (0 = leaves, each node of level `n` covers 1024 * 2^n bytes)
+		// for `toTree()`. A range covered by 1 such node can be verified alone: the TTH of that range equals the node.
+
+		public:
+			using Byte = uint8_t;
+			using ResultArrayType = Tiger1_192::ResultArrayType;
+
+#if (USE_STD_SPAN_CHOCOBO1_HASH == 1)
+			template <typename T, std::size_t Extent = std::dynamic_extent>
+			using Span = std::span<T, Extent>;
+#else
+			template <typename T, std::size_t Extent = gsl::dynamic_extent>
+			using Span = gsl::span<T, Extent>;
+#endif
+
+
+			explicit TTH(int exportLevel = -1);
+
+			void reset();
+			TTH& finalize();  // after this, only `operator T()`, `reset()`, `toArray()`, `toString()`, `toTree()`, `toVector()` are available
+
+			std::string toString() const;
+			std::vector<Byte> toVector() const;
+			ResultArrayType toArray() const;
+			template <typename T>
+			operator T() const noexcept;
+
+			// the levels from `exportLevel` up to the root, empty if `exportLevel` < 0
+			std::vector<std::vector<ResultArrayType>> toTree() const;
+
+			TTH& addData(Span<const Byte> inData);  // large inputs hash the leaves on separate threads
+			TTH& addData(const void *ptr, std::size_t length);
+			template <std::size_t N>
+			TTH& addData(const Byte (&array)[N]);
+			template <typename T, std::size_t N>
+			TTH& addData(const T (&array)[N]);
+			template <typename T>
+			TTH& addData(Span<T> inSpan);
+
+			friend bool operator==(const TTH &left, const TTH &right)
+			{
+				return ((left.m_exportLevel == right.m_exportLevel)
+					&& (left.m_leafCount == right.m_leafCount)
+					&& (left.m_buffer == right.m_buffer)
+					&& (left.m_stack == right.m_stack)
+					&& (left.m_exported == right.m_exported)
+					&& (left.m_result == right.m_result));
+			}
+			friend bool operator!=(const TTH &left, const TTH &right)
+			{
+				return !(left == right);
+			}
+
+		private:
+			static constexpr std::size_t LEAF_SIZE = 1024;
+			static constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;  // smaller inputs aren't worth the threads
+			static constexpr std::size_t TASK_SIZE = 256 * 1024;  // a large input is handed to the workers in pieces of about this size
+
+			void addDataImpl(Span<const Byte> data);
+			void addLeaves(Span<const Byte> data, bool parallel);
+			void addNode(const ResultArrayType &leaf);
+			static void hashLeaves(Span<const Byte> data, ResultArrayType *leaves);
+			static ResultArrayType hashLeaf(Span<const Byte> data);
+			static ResultArrayType hashNode(const ResultArrayType &left, const ResultArrayType &right);
+
+			int m_exportLevel = -1;
+
+			std::vector<Byte> m_buffer;  // current leaf
+			uint64_t m_leafCount = 0;
+			std::vector<std::pair<int, ResultArrayType>> m_stack;  // (level, node), the levels decrease towards the back
+			std::vector<ResultArrayType> m_exported;  // nodes of `m_exportLevel`
+
+			ResultArrayType m_result {};
+	};
+
+
+	//
+	inline TTH::TTH(const int exportLevel)
+		: m_exportLevel(exportLevel)
+	{
+		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
+
+		m_buffer.reserve(LEAF_SIZE);
+	}
+
+	inline void TTH::reset()
+	{
+		m_buffer.clear();
+		m_leafCount = 0;
+		m_stack.clear();
+		m_exported.clear();
+		m_result = {};
+	}
+
+	inline TTH& TTH::finalize()
+	{
+		// the empty input is 1 empty leaf
+		if (!m_buffer.empty() || (m_leafCount == 0))
+			addNode(hashLeaf(m_buffer));
+		m_buffer.clear();
+
+		// fold the subtrees from the right, the nodes below `m_exportLevel` make up its last node
+		std::size_t i = m_stack.size() - 1;
+		ResultArrayType node = m_stack[i].second;
+		for (; (i > 0) && (m_stack[i - 1].first < m_exportLevel); --i)
+			node = hashNode(m_stack[i - 1].second, node);
+		if (m_stack.back().first < m_exportLevel)
+			m_exported.emplace_back(node);
+		for (; i > 0; --i)
+			node = hashNode(m_stack[i - 1].second, node);
+
+		m_result = node;
+		m_stack.clear();
+
+		return (*this);
+	}
+
+	inline std::string TTH::toString() const
+	{
+		std::string ret;
+		ret.resize(2 * m_result.size());
+
+		auto *retPtr = &ret.front();
+		for (const auto c : m_result)
+		{
+			const Byte upper = ror<Byte>(c, 4);
+			*(retPtr++) = static_cast<char>((upper < 10) ? (upper + '0') : (upper - 10 + 'a'));
+
+			const Byte lower = c & 0xf;
+			*(retPtr++) = static_cast<char>((lower < 10) ? (lower + '0') : (lower - 10 + 'a'));
+		}
+
+		return ret;
+	}
+
+	inline std::vector<TTH::Byte> TTH::toVector() const
+	{
+		return {m_result.begin(), m_result.end()};
+	}
+
+	inline TTH::ResultArrayType TTH::toArray() const
+	{
+		return m_result;
+	}
+
+	template <typename T>
+	TTH::operator T() const noexcept
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+
+		T ret = 0;
+		for (int i = 0, iMax = static_cast<int>(std::min(sizeof(T), m_result.size())); i < iMax; ++i)
+		{
+			ret <<= 8;
+			ret |= m_result[i];
+		}
+		return ret;
+	}
+
+	inline std::vector<std::vector<TTH::ResultArrayType>> TTH::toTree() const
+	{
+		std::vector<std::vector<ResultArrayType>> ret;
+		if (m_exported.empty())
+			return ret;
+
+		ret.emplace_back(m_exported);
+		while (ret.back().size() > 1)
+		{
+			const std::vector<ResultArrayType> &level = ret.back();
+
+			std::vector<ResultArrayType> above;
+			above.reserve((level.size() + 1) / 2);
+			for (std::size_t i = 0; (i + 1) < level.size(); i += 2)
+				above.emplace_back(hashNode(level[i], level[i + 1]));
+			if ((level.size() % 2) != 0)
+				above.emplace_back(level.back());
+
+			ret.emplace_back(std::move(above));
+		}
+
+		return ret;
+	}
+
+	inline TTH& TTH::addData(const Span<const Byte> inData)
+	{
+		addDataImpl(inData);
+		return (*this);
+	}
+
+	inline TTH& TTH::addData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <std::size_t N>
+	TTH& TTH::addData(const Byte (&array)[N])
+	{
+		return addData({array, N});
+	}
+
+	template <typename T, std::size_t N>
+	TTH& TTH::addData(const T (&array)[N])
+	{
+		return addData({reinterpret_cast<const Byte*>(array), (sizeof(T) * N)});
+	}
+
+	template <typename T>
+	TTH& TTH::addData(const Span<T> inSpan)
+	{
+		return addData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
+	}
+
+	inline void TTH::addDataImpl(const Span<const Byte> inData)
+	{
+		// a full leaf is passed on only when more data follows, the last leaf stays in `m_buffer` for `finalize()`
+
+		// decided on the whole input, the leaves passed on are fewer and would miss the threshold with fixed size reads
+		const bool parallel = (static_cast<std::size_t>(inData.size()) >= MIN_PARALLEL_SIZE);
+
+		Span<const Byte> data = inData;
+		while (!data.empty())
+		{
+			if (m_buffer.size() == LEAF_SIZE)
+			{
+				addNode(hashLeaf(m_buffer));
+				m_buffer.clear();
+			}
+
+			if (m_buffer.empty() && (static_cast<std::size_t>(data.size()) > LEAF_SIZE))
+			{
+				// whole leaves are hashed straight from the input
+				const std::size_t len = ((static_cast<std::size_t>(data.size()) - 1) / LEAF_SIZE) * LEAF_SIZE;
+				addLeaves(data.first(len), parallel);
+				data = data.subspan(len);
+				continue;
+			}
+
+			const std::size_t len = std::min((LEAF_SIZE - m_buffer.size()), static_cast<std::size_t>(data.size()));
+			m_buffer.insert(m_buffer.end(), data.begin(), (data.begin() + len));
+			data = data.subspan(len);
+		}
+	}
+
+	inline void TTH::addLeaves(const Span<const Byte> data, const bool parallel)
+	{
+		// `data` holds whole leaves only, they are added to the tree in order
+		const std::size_t count = static_cast<std::size_t>(data.size()) / LEAF_SIZE;
+
+		std::vector<ResultArrayType> leaves(count);
+
+		const std::size_t tasks = parallel
+			? std::min(count, std::max<std::size_t>((static_cast<std::size_t>(data.size()) / TASK_SIZE), 1))
+			: 1;
+		threadPool().parallelFor(tasks, [&](const std::size_t i) -> void
+		{
+			const std::size_t first = (count * i) / tasks;
+			const std::size_t last = (count * (i + 1)) / tasks;
+			hashLeaves(data.subspan((first * LEAF_SIZE), ((last - first) * LEAF_SIZE)), (leaves.data() + first));
+		});
+
+		for (const auto &leaf : leaves)
+			addNode(leaf);
+	}
+
+	inline void TTH::addNode(const ResultArrayType &leaf)
+	{
+		// merge the subtrees of the same size, like a binary counter
+		m_stack.emplace_back(0, leaf);
+		++m_leafCount;
+		if (m_exportLevel == 0)
+			m_exported.emplace_back(leaf);
+
+		while ((m_stack.size() >= 2) && (m_stack[m_stack.size() - 2].first == m_stack.back().first))
+		{
+			const int level = m_stack.back().first + 1;
+			const ResultArrayType node = hashNode(m_stack[m_stack.size() - 2].second, m_stack.back().second);
+			m_stack.pop_back();
+			m_stack.back() = {level, node};
+
+			if (level == m_exportLevel)
+				m_exported.emplace_back(node);
+		}
+	}
+
+	inline void TTH::hashLeaves(const Span<const Byte> data, ResultArrayType *leaves)
+	{
+		for (std::size_t i = 0; i < static_cast<std::size_t>(data.size()); i += LEAF_SIZE)
+			*(leaves++) = hashLeaf(data.subspan(i, LEAF_SIZE));
+	}
+
+	inline TTH::ResultArrayType TTH::hashLeaf(const Span<const Byte> data)
+	{
+		const Byte prefix[1] = {0x00};
+		return Tiger1_192().addData(prefix).addData(data).finalize().toArray();
+	}
+
+	inline TTH::ResultArrayType TTH::hashNode(const ResultArrayType &left, const ResultArrayType &right)
+	{
+		const Byte prefix[1] = {0x01};
+		return Tiger1_192().addData(prefix).addData(left.data(), left.size()).addData(right.data(), right.size()).finalize().toArray();
+	}
+}
+}
+
+	using TTH = Hash::TTH_NS::TTH;
+}
+
+namespace std
+{
+	template <>
+	struct hash<Chocobo1::TTH>
+	{
+		size_t operator()(const Chocobo1::TTH &hash) const noexcept
+		{
+			return hash;
+		}
+	};
+}
+
+#endif  // CHOCOBO1_TTH_H
@@ -14,6 +14,7 @@
 
 #include "cshake.h"
 
+#include <cassert>
 #include <climits>
 #include <cmath>
 #include <cstdint>
@@ -83,17 +84,31 @@ namespace TupleHash_NS
 #endif
 
 
+			class Prefix
+			{
+				// the absorbed customization, can be shared by instances of any digest length
+				public:
+					explicit Prefix(const std::string &customize = {}) : m_prefix("TupleHash", customize) {}
+
+				private:
+					friend class TupleHash;
+
+					typename Alg::Prefix m_prefix;
+			};
+
+
 			explicit constexpr TupleHash(int digestLength, const std::string &customize = {});
+			static TupleHash fromPrefix(const Prefix &prefix, int digestLength);  // skips absorbing the customization again
 
 			constexpr void reset();
-			constexpr TupleHash& finalize();  // after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
+			constexpr TupleHash& finalize();  // precondition: no element is open. after this, only `operator T()`, `reset()`, `toString()`, `toVector()` are available
 
 			std::string toString() const;
 			std::vector<Byte> toVector() const;
 			template <typename T>
 			operator T() const noexcept;
 
-			constexpr TupleHash& nextData(Span<const Byte> inData);  // pass in next element in tuple
+			constexpr TupleHash& nextData(Span<const Byte> inData);  // pass in next element in tuple, precondition: no element is open
 			constexpr TupleHash& nextData(const void *ptr, std::size_t length);
 			template <std::size_t N>
 			constexpr TupleHash& nextData(const Byte (&array)[N]);
@@ -102,9 +117,19 @@ namespace TupleHash_NS
 			template <typename T>
 			TupleHash& nextData(Span<T> inSpan);
 
+			// pass in next element in tuple piece by piece, the element length must be known beforehand
+			// preconditions, only checked by `assert()`, breaking them gives a wrong digest:
+			// `beginElement()` only when no element is open, the element is open until exactly `length` bytes are added,
+			// `addElementData()` never exceeds the length, `endElement()` only after all bytes are added
+			constexpr TupleHash& beginElement(uint64_t length);
+			constexpr TupleHash& addElementData(Span<const Byte> inData);
+			constexpr TupleHash& addElementData(const void *ptr, std::size_t length);
+			constexpr TupleHash& endElement();
+
 			friend constexpr bool operator==(const TupleHash &left, const TupleHash &right)
 			{
-				return (left.m_cshake == right.m_cshake);
+				return ((left.m_cshake == right.m_cshake)
+					&& (left.m_elementRemaining == right.m_elementRemaining));
 			}
 			friend constexpr bool operator!=(const TupleHash &left, const TupleHash &right)
 			{
@@ -112,10 +137,13 @@ namespace TupleHash_NS
 			}
 
 		private:
+			TupleHash(Alg &&cshake, int digestLength);
+
 			constexpr void addDataImpl(Span<const Byte> data);
 
 			Alg m_cshake;
 			int m_digestLength = 0;
+			uint64_t m_elementRemaining = 0;  // bytes of the current element not yet passed in
 	};
 
 
@@ -142,15 +170,31 @@ namespace TupleHash_NS
 		static_assert((CHAR_BIT == 8), "Sorry, we don't support exotic CPUs");
 	}
 
+	template <typename Alg>
+	TupleHash<Alg>::TupleHash(Alg &&cshake, const int digestLength)
+		: m_cshake(std::move(cshake))
+		, m_digestLength(digestLength)
+	{
+	}
+
+	template <typename Alg>
+	TupleHash<Alg> TupleHash<Alg>::fromPrefix(const Prefix &prefix, const int digestLength)
+	{
+		return TupleHash(Alg::fromPrefix(prefix.m_prefix, digestLength), digestLength);
+	}
+
 	template <typename Alg>
 	constexpr void TupleHash<Alg>::reset()
 	{
 		m_cshake.reset();
+		m_elementRemaining = 0;
 	}
 
 	template <typename Alg>
 	constexpr TupleHash<Alg>& TupleHash<Alg>::finalize()
 	{
+		assert(m_elementRemaining == 0);
+
 		const auto encoded = rightEncode(m_digestLength * 8);
 		addDataImpl({encoded.data(), encoded.size()});
 		m_cshake.finalize();
@@ -188,11 +232,7 @@ namespace TupleHash_NS
 	template <typename Alg>
 	constexpr TupleHash<Alg>& TupleHash<Alg>::nextData(const Span<const Byte> inData)
 	{
-		const auto encoded = Chocobo1::Hash::CShake_NS::leftEncode(inData.size() * 8);
-		addDataImpl({encoded.data(), encoded.size()});
-		addDataImpl(inData);
-
-		return (*this);
+		return beginElement(inData.size()).addElementData(inData).endElement();
 	}
 
 	template <typename Alg>
@@ -223,6 +263,43 @@ namespace TupleHash_NS
 		return nextData({reinterpret_cast<const Byte*>(inSpan.data()), inSpan.size_bytes()});
 	}
 
+	template <typename Alg>
+	constexpr TupleHash<Alg>& TupleHash<Alg>::beginElement(const uint64_t length)
+	{
+		assert(m_elementRemaining == 0);
+
+		const auto encoded = Chocobo1::Hash::CShake_NS::leftEncode(length * 8);
+		addDataImpl({encoded.data(), encoded.size()});
+		m_elementRemaining = length;
+
+		return (*this);
+	}
+
+	template <typename Alg>
+	constexpr TupleHash<Alg>& TupleHash<Alg>::addElementData(const Span<const Byte> inData)
+	{
+		assert(static_cast<uint64_t>(inData.size()) <= m_elementRemaining);
+
+		addDataImpl(inData);
+		m_elementRemaining -= inData.size();
+
+		return (*this);
+	}
+
+	template <typename Alg>
+	constexpr TupleHash<Alg>& TupleHash<Alg>::addElementData(const void *ptr, const std::size_t length)
+	{
+		// Span::size_type = std::size_t
+		return addElementData({static_cast<const Byte*>(ptr), length});
+	}
+
+	template <typename Alg>
+	constexpr TupleHash<Alg>& TupleHash<Alg>::endElement()
+	{
+		assert(m_elementRemaining == 0);
+		return (*this);
+	}
+
 	template <typename Alg>
 	constexpr void TupleHash<Alg>::addDataImpl(const Span<const Byte> data)
 	{
@@ -240,6 +317,7 @@ namespace TupleHash_NS
 		TupleHashAlias(Base &&other) noexcept : Base(std::move(other)) {}
 		TupleHashAlias& operator=(const Base &other) { if (this != &other) { Base::operator=(other); } return *this; }
 		TupleHashAlias& operator=(Base &&other) noexcept { if (this != &other) { Base::operator=(std::move(other)); } return *this; }
+		static TupleHashAlias fromPrefix(const typename Base::Prefix &p, const int l) { return TupleHashAlias(Base::fromPrefix(p, l)); }
 	};
 	using TupleHash_128 = TupleHashAlias<Hash::TupleHash_NS::TupleHash<CSHAKE_128>>;
 	using TupleHash_256 = TupleHashAlias<Hash::TupleHash_NS::TupleHash<CSHAKE_256>>;
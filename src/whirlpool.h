@@ -40,6 +40,12 @@
 #include "gsl/span"
 #endif
 
+#ifndef USE_WHIRLPOOL_COMPACT_TABLE_CHOCOBO1_HASH
+// 1: use 1 lookup table (2 KiB) & rotations instead of 8 tables (16 KiB)
+// slower alone but leaves more of the L1 cache to other code
+#define USE_WHIRLPOOL_COMPACT_TABLE_CHOCOBO1_HASH 0
+#endif
+
 
 namespace Chocobo1
 {
@@ -246,6 +252,18 @@ namespace Hash
 	}
 #endif
 
+#ifndef CHOCOBO1_HASH_ROTR_IMPL
+#define CHOCOBO1_HASH_ROTR_IMPL
+	template <typename T>
+	constexpr T rotr(const T x, const unsigned int s)
+	{
+		static_assert(std::is_unsigned<T>::value, "");
+		if (s == 0)
+			return x;
+		return ((x >> s) | (x << ((sizeof(T) * 8) - s)));
+	}
+#endif
+
 
 namespace Whirlpool_NS
 {
@@ -311,7 +329,10 @@ namespace Whirlpool_NS
 
 			uint64_t m_h[8] = {};
 
-			INLINE_CLASS_VARIABLE_CHOCOBO1_HASH uint64_t cTable[8][256] =
+			// table `k` is table 0 rotated right by `8 * k` bits
+			static constexpr int TABLE_COUNT = (USE_WHIRLPOOL_COMPACT_TABLE_CHOCOBO1_HASH == 1) ? 1 : 8;
+
+			INLINE_CLASS_VARIABLE_CHOCOBO1_HASH uint64_t cTable[TABLE_COUNT][256] =
 			{
 				{
 					0x18186018c07830d8, 0x23238c2305af4626, 0xc6c63fc67ef991b8, 0xe8e887e8136fcdfb, 0x878726874ca113cb, 0xb8b8dab8a9626d11, 0x0101040108050209, 0x4f4f214f426e9e0d,
@@ -347,6 +368,7 @@ namespace Whirlpool_NS
 					0x16165816b04e2ca6, 0x3a3ae83acdd274f7, 0x6969b9696fd0d206, 0x09092409482d1241, 0x7070dd70a7ade0d7, 0xb6b6e2b6d954716f, 0xd0d067d0ceb7bd1e, 0xeded93ed3b7ec7d6,
 					0xcccc17cc2edb85e2, 0x424215422a578468, 0x98985a98b4c22d2c, 0xa4a4aaa4490e55ed, 0x2828a0285d885075, 0x5c5c6d5cda31b886, 0xf8f8c7f8933fed6b, 0x8686228644a411c2
 				},
+#if (USE_WHIRLPOOL_COMPACT_TABLE_CHOCOBO1_HASH == 0)
 				{
 					0xd818186018c07830, 0x2623238c2305af46, 0xb8c6c63fc67ef991, 0xfbe8e887e8136fcd, 0xcb878726874ca113, 0x11b8b8dab8a9626d, 0x0901010401080502, 0x0d4f4f214f426e9e,
 					0x9b3636d836adee6c, 0xffa6a6a2a6590451, 0x0cd2d26fd2debdb9, 0x0ef5f5f3f5fb06f7, 0x967979f979ef80f2, 0x306f6fa16f5fcede, 0x6d91917e91fcef3f, 0xf852525552aa07a4,
@@ -585,6 +607,7 @@ namespace Whirlpool_NS
 					0x165816b04e2ca616, 0x3ae83acdd274f73a, 0x69b9696fd0d20669, 0x092409482d124109, 0x70dd70a7ade0d770, 0xb6e2b6d954716fb6, 0xd067d0ceb7bd1ed0, 0xed93ed3b7ec7d6ed,
 					0xcc17cc2edb85e2cc, 0x4215422a57846842, 0x985a98b4c22d2c98, 0xa4aaa4490e55eda4, 0x28a0285d88507528, 0x5c6d5cda31b8865c, 0xf8c7f8933fed6bf8, 0x86228644a411c286
 				}
+#endif
 			};
 
 			INLINE_CLASS_VARIABLE_CHOCOBO1_HASH uint64_t roundConstant[ROUND] =
@@ -828,10 +851,17 @@ namespace Whirlpool_NS
 				const auto func = [this](const uint64_t *x, const unsigned int a, const unsigned int b, const unsigned int c, const unsigned int d, const unsigned int e, const unsigned int f, const unsigned int g, const unsigned int h) -> uint64_t
 #endif
 				{
+#if (USE_WHIRLPOOL_COMPACT_TABLE_CHOCOBO1_HASH == 1)
+					return cTable[0][ror<Byte>(x[a], 56)] ^ rotr(cTable[0][ror<Byte>(x[b], 48)], 8)
+						 ^ rotr(cTable[0][ror<Byte>(x[c], 40)], 16) ^ rotr(cTable[0][ror<Byte>(x[d], 32)], 24)
+						 ^ rotr(cTable[0][ror<Byte>(x[e], 24)], 32) ^ rotr(cTable[0][ror<Byte>(x[f], 16)], 40)
+						 ^ rotr(cTable[0][ror<Byte>(x[g], 8)], 48)  ^ rotr(cTable[0][ror<Byte>(x[h], 0)], 56);
+#else
 					return cTable[0][ror<Byte>(x[a], 56)] ^ cTable[1][ror<Byte>(x[b], 48)]
 						 ^ cTable[2][ror<Byte>(x[c], 40)] ^ cTable[3][ror<Byte>(x[d], 32)]
 						 ^ cTable[4][ror<Byte>(x[e], 24)] ^ cTable[5][ror<Byte>(x[f], 16)]
 						 ^ cTable[6][ror<Byte>(x[g], 8)]  ^ cTable[7][ror<Byte>(x[h], 0)];
+#endif
 				};
 
 				// compute K^r from K^(r - 1)
@@ -0,0 +1,153 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_X86_SIMD_H
+#define CHOCOBO1_X86_SIMD_H
+
+// internal header: the runtime CPU feature detection shared by the algorithms with x86 SIMD code paths
+
+#include <cstdint>
+
+#ifndef USE_X86_SIMD_CHOCOBO1_HASH
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+// runtime dispatching requires `__builtin_is_constant_evaluated()` so that constexpr evaluation keeps using the portable code
+#if defined(__clang__)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define USE_X86_SIMD_CHOCOBO1_HASH 1
+#endif
+#elif defined(__GNUC__)
+#if (__GNUC__ >= 9)
+#define USE_X86_SIMD_CHOCOBO1_HASH 1
+#endif
+#elif defined(_MSC_VER)
+#if (_MSC_VER >= 1925)
+#define USE_X86_SIMD_CHOCOBO1_HASH 1
+#endif
+#endif
+#endif
+#ifndef USE_X86_SIMD_CHOCOBO1_HASH
+#define USE_X86_SIMD_CHOCOBO1_HASH 0
+#endif
+#endif
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace Chocobo1
+{
+// users should ignore things in this namespace
+
+namespace Hash
+{
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+#if defined(__GNUC__) || defined(__clang__)
+#define X86_TARGET_CHOCOBO1_HASH(features) __attribute__((target(features)))
+#else
+#define X86_TARGET_CHOCOBO1_HASH(features)
+#endif
+
+	constexpr bool isConstantEvaluated() noexcept
+	{
+		return __builtin_is_constant_evaluated();
+	}
+
+	struct CpuFeatures
+	{
+		bool sse2 = false;
+		bool ssse3 = false;
+		bool sse41 = false;
+		bool sse42 = false;
+		bool pclmul = false;
+		bool avx = false;
+		bool avx2 = false;
+		bool sha = false;
+	};
+
+	inline CpuFeatures detectCpuFeatures()
+	{
+		const auto cpuid = [](const unsigned int leaf, const unsigned int subleaf, unsigned int (&regs)[4]) -> void
+		{
+#if defined(_MSC_VER)
+			int r[4] {};
+			__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+			for (int i = 0; i < 4; ++i)
+				regs[i] = static_cast<unsigned int>(r[i]);
+#else
+			__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		};
+		const auto xgetbv = []() -> uint64_t
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t eax = 0;
+			uint32_t edx = 0;
+			__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return ((static_cast<uint64_t>(edx) << 32) | eax);
+#endif
+		};
+		const auto bit = [](const unsigned int reg, const int pos) -> bool
+		{
+			return (((reg >> pos) & 1) != 0);
+		};
+
+		CpuFeatures ret;
+
+		unsigned int regs[4] {};  // eax, ebx, ecx, edx
+		cpuid(0, 0, regs);
+		const unsigned int maxLeaf = regs[0];
+		if (maxLeaf < 1)
+			return ret;
+
+		cpuid(1, 0, regs);
+		ret.sse2 = bit(regs[3], 26);
+		ret.ssse3 = bit(regs[2], 9);
+		ret.sse41 = bit(regs[2], 19);
+		ret.sse42 = bit(regs[2], 20);
+		ret.pclmul = bit(regs[2], 1);
+		// AVX also needs the OS to save the YMM registers on context switches
+		if (bit(regs[2], 27) && bit(regs[2], 28))
+			ret.avx = ((xgetbv() & 0x6) == 0x6);
+
+		if (maxLeaf >= 7)
+		{
+			cpuid(7, 0, regs);
+			ret.avx2 = (ret.avx && bit(regs[1], 5));
+			ret.sha = bit(regs[1], 29);
+		}
+
+		return ret;
+	}
+
+	inline CpuFeatures& cpuFeaturesForTesting()
+	{
+		// only for tests that force other code paths, changing the flags while another thread hashes is a data race
+		static CpuFeatures features = detectCpuFeatures();
+		return features;
+	}
+
+	inline const CpuFeatures& cpuFeatures()
+	{
+		return cpuFeaturesForTesting();
+	}
+#endif
+}
+}
+
+#endif  // CHOCOBO1_X86_SIMD_H
@@ -12,6 +12,7 @@
 #include "../src/blake2.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -72,3 +73,24 @@ TEST_CASE("blake2")  // NOLINT
 
 	REQUIRE(0x786a02f742015903 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("blake2-simd")  // NOLINT
+{
+	using Hash = Chocobo1::Blake2;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("AVX2", {&Features::avx2}, []() -> void
+	{
+		const char s1[] = "abc";
+		REQUIRE("ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("1e24e9301b719e13b71bc5e3e033a8f121c57c714216b4ba7e18169cc30d96828844725b4765cadea2e2a0a892154342d30899e7f054659139622602e78bb83a" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(1000, 7), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
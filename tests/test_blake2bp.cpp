@@ -0,0 +1,73 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/blake2bp.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+
+#include <cstring>
+
+
+TEST_CASE("blake2bp")  // NOLINT
+{
+	using Hash = Chocobo1::Blake2bp;
+
+	// official test suite
+	REQUIRE("b5ef811a8038f70b628fa8b294daae7492b1ebe343a80eaabbf1f6ae664dd67b9d90b0120791eab81dc96985f28849f6a305186a85501b405114bfa678df9380"
+			== Hash().finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash() == Hash());
+	REQUIRE(Hash().addData("123").finalize() != Hash().finalize());
+
+	const char s11[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("f10e0523631699102c63412c0701fa19f6550fbac0e9c035803c6033b50465222bb92ee0af0dad53edca32f0e08a72c077a6cafc6f4d24a7fb649079d47ce089"
+			== Hash().addData(s11, strlen(s11)).finalize().toString());
+
+	const char s12[] = "The quick brown fox jumps over the lazy dog.";
+	REQUIRE("e3c82f707f793ffde046e490ee6e6fa0be2def4ff20aa5a63eb0bf9475381301f4b041e3fea156aea06d14042c2d6e00fb29af53633a2b4b83ae4256d923bb72"
+			== Hash().addData(s12, strlen(s12)).finalize().toString());
+
+	const char s13[] = "The quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dog";
+	REQUIRE("083cec5d40716dbfee0c80c53fa0de4128ea35ad1f638fe07214bcefb00346fab7fd355c88815f4309eddfe849d27ccef5e4afe4ffff8c86abbc80970be7681e"
+			== Hash().addData(s13, strlen(s13)).finalize().toString());
+
+	const std::vector<char> s14(512, 'a');  // length == 4 leaves * BLOCK_SIZE
+	REQUIRE("6e30a2e1328ca8f080ac21fdb76e8aee7a1277b12957334af7540371800cdda41218413ff4564f48fb30ecfae131aa433a553c5db1899f468d63c69a29fefce9"
+			== Hash().addData(s14.data(), s14.size()).finalize().toString());
+
+	const std::vector<char> s15(513, 'a');
+	REQUIRE("89d15451230d3078141dac62412a9330377e9f1ad19227594f981d781ead19a1b95ab87f184275b8f2153640c8ff1eb9a53b2b8b9c0c279d39ee79befd0ec301"
+			== Hash().addData(s15.data(), s15.size()).finalize().toString());
+	REQUIRE("89d15451230d3078141dac62412a9330377e9f1ad19227594f981d781ead19a1b95ab87f184275b8f2153640c8ff1eb9a53b2b8b9c0c279d39ee79befd0ec301"
+			== Hash().addData(s15.data(), 100).addData(s15.data() + 100, 300).addData(s15.data() + 400, 113).finalize().toString());
+
+	const std::vector<char> s16((3 * 1024 * 1024) + 5, 'a');  // hashed on the thread pool
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	REQUIRE("03225bae67f6e002255ecb6a471c4d30096b9c54a073d52e0ac65bdcea7af1d5fac77ac96c106227ca3a499bc8fe5d09da9ebcdc26be24d5fd33cb50b480243e"
+			== Hash().addData(s16.data(), s16.size()).finalize().toString());
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+	REQUIRE("03225bae67f6e002255ecb6a471c4d30096b9c54a073d52e0ac65bdcea7af1d5fac77ac96c106227ca3a499bc8fe5d09da9ebcdc26be24d5fd33cb50b480243e"
+			== Hash().addData(s16.data(), 3).addData(s16.data() + 3, (s16.size() - 3)).finalize().toString());
+
+	const int s17[2] = {0};
+	const char s17_2[8] = {0};
+	REQUIRE(Hash().addData(Hash::Span<const int>(s17)).finalize().toString()
+			== Hash().addData(s17_2).finalize().toString());
+
+	const unsigned char s18[] = {0x00, 0x0A};
+	const auto s18_1 = Hash().addData(s18, 2).finalize().toArray();
+	const auto s18_2 = Hash().addData(s18).finalize().toArray();
+	REQUIRE(s18_1 == s18_2);
+
+	REQUIRE(0xb5ef811a8038f70b == std::hash<Hash> {}(Hash().finalize()));
+}
@@ -12,6 +12,7 @@
 #include "../src/blake2s.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -72,3 +73,24 @@ TEST_CASE("blake2s")  // NOLINT
 
 	REQUIRE(0x69217a3079908094 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("blake2s-simd")  // NOLINT
+{
+	using Hash = Chocobo1::Blake2s;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("SSE4.1", {&Features::sse41}, []() -> void
+	{
+		const char s1[] = "abc";
+		REQUIRE("508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("4dcb474dece8286aa079de6cea1bd08b9aaa4680ff44bd619041190bbf92e074" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(1000, 7), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/blake2sp.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+
+#include <cstring>
+
+
+TEST_CASE("blake2sp")  // NOLINT
+{
+	using Hash = Chocobo1::Blake2sp;
+
+	// official test suite
+	REQUIRE("dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f"
+			== Hash().finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash() == Hash());
+	REQUIRE(Hash().addData("123").finalize() != Hash().finalize());
+
+	const char s11[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("cf192976714bb648e72b29fa90e6bf0fbc5bf2efe7d5c26ed8ff34e855368691"
+			== Hash().addData(s11, strlen(s11)).finalize().toString());
+
+	const char s12[] = "The quick brown fox jumps over the lazy dog.";
+	REQUIRE("9adcc03dbd57bb170ddd9efbe748f03695251767828ef6a0f0451b366823ebfd"
+			== Hash().addData(s12, strlen(s12)).finalize().toString());
+
+	const char s13[] = "The quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dog";
+	REQUIRE("76b765178275912e5cd8c6881844643ad094559d0492f76505da5a03edae6794"
+			== Hash().addData(s13, strlen(s13)).finalize().toString());
+
+	const std::vector<char> s14(512, 'a');  // length == 8 leaves * BLOCK_SIZE
+	REQUIRE("e5c78b5cd735530b80a1377388c29164a54192ed3b1a745bce45488d1188e9bc"
+			== Hash().addData(s14.data(), s14.size()).finalize().toString());
+
+	const std::vector<char> s15(513, 'a');
+	REQUIRE("985dfa163dbd74d7a74a42f57144bb8dd99a0395c1953404a73c585c567b1037"
+			== Hash().addData(s15.data(), s15.size()).finalize().toString());
+	REQUIRE("985dfa163dbd74d7a74a42f57144bb8dd99a0395c1953404a73c585c567b1037"
+			== Hash().addData(s15.data(), 100).addData(s15.data() + 100, 300).addData(s15.data() + 400, 113).finalize().toString());
+
+	const std::vector<char> s16((3 * 1024 * 1024) + 5, 'a');  // hashed on the thread pool
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	REQUIRE("f18a0b5c52f5b6e1ab28a111a0eb147930845f994c78781f53dca460fa15e222"
+			== Hash().addData(s16.data(), s16.size()).finalize().toString());
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+	REQUIRE("f18a0b5c52f5b6e1ab28a111a0eb147930845f994c78781f53dca460fa15e222"
+			== Hash().addData(s16.data(), 3).addData(s16.data() + 3, (s16.size() - 3)).finalize().toString());
+
+	const int s17[2] = {0};
+	const char s17_2[8] = {0};
+	REQUIRE(Hash().addData(Hash::Span<const int>(s17)).finalize().toString()
+			== Hash().addData(s17_2).finalize().toString());
+
+	const unsigned char s18[] = {0x00, 0x0A};
+	const auto s18_1 = Hash().addData(s18, 2).finalize().toArray();
+	const auto s18_2 = Hash().addData(s18).finalize().toArray();
+	REQUIRE(s18_1 == s18_2);
+
+	REQUIRE(0xdd0e891776933f43 == std::hash<Hash> {}(Hash().finalize()));
+}
@@ -0,0 +1,163 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/blake3.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+#include <utility>
+
+
+TEST_CASE("blake3")  // NOLINT
+{
+	using Hash = Chocobo1::Blake3;
+
+	// official test vectors
+	// https://github.com/BLAKE3-team/BLAKE3/blob/master/test_vectors/test_vectors.json
+	const std::pair<std::size_t, const char *> hashVectors[] =
+	{
+		{     0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+		{     1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+		{  1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+		{  1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+		{  1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+		{  2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+		{  2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030"},
+		{  3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2"},
+		{  3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+		{  4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969"},
+		{  4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995"},
+		{  5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833"},
+		{  5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff"},
+		{  6144, "3e2e5b74e048f3add6d21faab3f83aa44d3b2278afb83b80b3c35164ebeca205"},
+		{  6145, "f1323a8631446cc50536a9f705ee5cb619424d46887f3c376c695b70e0f0507f"},
+		{  7168, "61da957ec2499a95d6b8023e2b0e604ec7f6b50e80a9678b89d2628e99ada77a"},
+		{  7169, "a003fc7a51754a9b3c7fae0367ab3d782dccf28855a03d435f8cfe74605e7817"},
+		{  8192, "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63"},
+		{  8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+		{ 16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4"},
+		{ 31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+		{102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+	};
+	for (const auto &vector : hashVectors)
+	{
+		const auto input = TestHelpers::pattern(vector.first);
+		REQUIRE(vector.second == Hash().addData(input.data(), input.size()).finalize().toString());
+	}
+
+	const auto input1025 = TestHelpers::pattern(1025);
+	REQUIRE("d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444f4c4a22b4b399155358a994e52bf255de60035742ec71bd08ac275a1b51cc6bfe332b0ef84b409108cda080e6269ed4b3e2c3f7d722aa4cdc98d16deb554e5627be8f955c98e1d5f9565a9194cad0c4285f93700062d9595adb992ae68ff12800ab67a"
+			== Hash(131).addData(input1025.data(), input1025.size()).finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash() == Hash());
+	REQUIRE(Hash().addData("123").finalize() != Hash().finalize());
+
+	const char s11[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("2f1514181aadccd913abd94cfa592701a5686ab23f8df1dff1b74710febc6d4a"
+			== Hash().addData(s11, strlen(s11)).finalize().toString());
+
+	REQUIRE("af1349b9f5f9a1a6a0404dea36dcc949"
+			== Hash(16).finalize().toString());
+
+	const auto s13 = TestHelpers::pattern(8193);
+	REQUIRE("bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"
+			== Hash().addData(s13.data(), 1).addData(s13.data() + 1, 1100).addData(s13.data() + 1101, s13.size() - 1101).finalize().toString());
+	REQUIRE("bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"
+			== Hash().addData(s13.data(), 4096).addData(s13.data() + 4096, 4096).addData(s13.data() + 8192, 1).finalize().toString());
+
+	const std::vector<char> s14((3 * 1024 * 1024) + 5, 'a');
+	REQUIRE("c2b4f8957190caeb28d97ed72501eed5c816fb2c74c38194d464e66fc5501586"
+			== Hash().addData(s14.data(), s14.size()).finalize().toString());
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	REQUIRE("c2b4f8957190caeb28d97ed72501eed5c816fb2c74c38194d464e66fc5501586"
+			== Hash().addDataParallel({reinterpret_cast<const uint8_t *>(s14.data()), s14.size()}, 4).finalize().toString());
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+	REQUIRE("c2b4f8957190caeb28d97ed72501eed5c816fb2c74c38194d464e66fc5501586"
+			== Hash().addData(s14.data(), 1000).addDataParallel({reinterpret_cast<const uint8_t *>(s14.data() + 1000), (s14.size() - 1000)}, 3).finalize().toString());
+
+	const int s16[2] = {0};
+	const char s16_2[8] = {0};
+	REQUIRE(Hash().addData(Hash::Span<const int>(s16)).finalize().toString()
+			== Hash().addData(s16_2).finalize().toString());
+
+	const unsigned char s17[] = {0x00, 0x0A};
+	const auto s17_1 = Hash().addData(s17, 2).finalize().toArray();
+	const auto s17_2 = Hash().addData(s17).finalize().toArray();
+	REQUIRE(s17_1 == s17_2);
+
+	REQUIRE(0xaf1349b9f5f9a1a6 == std::hash<Hash> {}(Hash().finalize()));
+}
+
+TEST_CASE("blake3-keyed")  // NOLINT
+{
+	using Hash = Chocobo1::Blake3;
+
+	// official test vectors
+	const char keyString[] = "whats the Elvish word for friend";
+	const Hash::Span<const uint8_t> key {reinterpret_cast<const uint8_t *>(keyString), 32};
+
+	const std::pair<std::size_t, const char *> keyedVectors[] =
+	{
+		{     0, "92b2b75604ed3c761f9d6f62392c8a9227ad0ea3f09573e783f1498a4ed60d26"},
+		{     1, "6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b"},
+		{  1025, "357dc55de0c7e382c900fd6e320acc04146be01db6a8ce7210b7189bd664ea69"},
+		{  8193, "954a2a75420c8d6547e3ba5b98d963e6fa6491addc8c023189cc519821b4a1f5"},
+	};
+	for (const auto &vector : keyedVectors)
+	{
+		const auto input = TestHelpers::pattern(vector.first);
+		REQUIRE(vector.second == Hash(32, key).addData(input.data(), input.size()).finalize().toString());
+	}
+
+	const std::string context = "BLAKE3 2019-12-27 16:29:52 test vectors context";
+	const std::pair<std::size_t, const char *> deriveKeyVectors[] =
+	{
+		{     0, "2cc39783c223154fea8dfb7c1b1660f2ac2dcbd1c1de8277b0b0dd39b7e50d7d"},
+		{     1, "b3e2e340a117a499c6cf2398a19ee0d29cca2bb7404c73063382693bf66cb06c"},
+		{  1025, "effaa245f065fbf82ac186839a249707c3bddf6d3fdda22d1b95a3c970379bcb"},
+		{  8193, "af1e0346e389b17c23200270a64aa4e1ead98c61695d917de7d5b00491c9b0f1"},
+	};
+	for (const auto &vector : deriveKeyVectors)
+	{
+		const auto input = TestHelpers::pattern(vector.first);
+		REQUIRE(vector.second == Hash(32, context).addData(input.data(), input.size()).finalize().toString());
+	}
+
+	REQUIRE(Hash(32, key).finalize() != Hash().finalize());
+	REQUIRE(Hash(32, context).finalize() != Hash(32, key).finalize());
+}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("blake3-simd")  // NOLINT
+{
+	using Hash = Chocobo1::Blake3;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("AVX2", {&Features::avx2}, []() -> void
+	{
+		// official test vectors, long enough for the batches of 8 chunks
+		const auto s1 = TestHelpers::pattern(31744);
+		REQUIRE("aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63" == Hash().addData(s1.data(), 8192).finalize().toString());
+		REQUIRE("f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4" == Hash().addData(s1.data(), 16384).finalize().toString());
+		REQUIRE("62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47" == Hash().addData(s1.data(), s1.size()).finalize().toString());
+	});
+
+	// lengths around the batches of 8 chunks
+	TestHelpers::requireSimdMatchesPortable({0, 1, 1024, 7168, 8191, 8192, 8193, 9216, 16385, 31744, 40000}, [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash(100).addData(data, split).addData((data + split), (len - split)).finalize().toVector();
+	});
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/crc.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+TEST_CASE("crc")  // NOLINT
+{
+	// check values from: https://reveng.sourceforge.io/crc-catalogue/
+	const char check[] = "123456789";
+
+	REQUIRE("bb3d" == Chocobo1::CRC_16().addData(check, strlen(check)).finalize().toString());
+	REQUIRE("fc891918" == Chocobo1::CRC_32_BZIP2().addData(check, strlen(check)).finalize().toString());
+	REQUIRE("995dc9bbdf1939fa" == Chocobo1::CRC_64_XZ().addData(check, strlen(check)).finalize().toString());
+
+	// CRC-24/OPENPGP
+	using CRC_24 = Chocobo1::Hash::CRC_NS::CRC<24, 0x864CFB, 0xB704CE, false, false, 0>;
+	REQUIRE("21cf02" == CRC_24().addData(check, strlen(check)).finalize().toString());
+
+	// CRC-32/ISO-HDLC, same as `CRC_32`
+	using CRC_32 = Chocobo1::Hash::CRC_NS::CRC<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+	const char s11[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("414fa339" == CRC_32().addData(s11, strlen(s11)).finalize().toString());
+	REQUIRE(0x414fa339 == static_cast<uint32_t>(CRC_32().addData(s11, strlen(s11)).finalize()));
+	REQUIRE(0 == std::hash<CRC_32> {}(CRC_32().finalize()));
+
+	// my own tests
+	REQUIRE(Chocobo1::CRC_64_XZ() == Chocobo1::CRC_64_XZ());
+	REQUIRE(Chocobo1::CRC_64_XZ().addData("123").finalize() != Chocobo1::CRC_64_XZ().finalize());
+	REQUIRE("0000" == Chocobo1::CRC_16().finalize().toString());
+	REQUIRE("00000000" == Chocobo1::CRC_32_BZIP2().finalize().toString());
+	REQUIRE(sizeof(Chocobo1::CRC_64_XZ) == sizeof(uint64_t));
+
+	const int s12[2] = {0};
+	const char s12_2[8] = {0};
+	REQUIRE(Chocobo1::CRC_16().addData(Chocobo1::CRC_16::Span<const int>(s12)).finalize().toString()
+			== Chocobo1::CRC_16().addData(s12_2).finalize().toString());
+}
+
+TEST_CASE("crc-slices")  // NOLINT
+{
+	// every slice count must give the same result
+	const auto data = TestHelpers::noise(1000);
+
+	const auto test = [&data](auto hash1, auto hash4, auto hash8, auto hash16) -> void
+	{
+		for (size_t len = 0; len <= (data.size() - 1); len += 7)
+		{
+			const auto digest = decltype(hash1)().addData((data.data() + 1), len).finalize().toArray();
+			REQUIRE(digest == decltype(hash4)().addData((data.data() + 1), len).finalize().toArray());
+			REQUIRE(digest == decltype(hash8)().addData((data.data() + 1), len).finalize().toArray());
+			REQUIRE(digest == decltype(hash16)().addData((data.data() + 1), len).finalize().toArray());
+		}
+	};
+
+	using namespace Chocobo1::Hash::CRC_NS;
+	test(CRC<16, 0x8005, 0x0000, true, true, 0x0000, 1>(), CRC<16, 0x8005, 0x0000, true, true, 0x0000, 4>()
+		, CRC<16, 0x8005, 0x0000, true, true, 0x0000, 8>(), CRC<16, 0x8005, 0x0000, true, true, 0x0000, 16>());
+	test(CRC<24, 0x864CFB, 0xB704CE, false, false, 0, 1>(), CRC<24, 0x864CFB, 0xB704CE, false, false, 0, 4>()
+		, CRC<24, 0x864CFB, 0xB704CE, false, false, 0, 8>(), CRC<24, 0x864CFB, 0xB704CE, false, false, 0, 16>());
+	test(CRC<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 1>(), CRC<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 4>()
+		, CRC<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 8>(), CRC<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 16>());
+	test(CRC<64, 0x42F0E1EBA9EA3693, ~0ull, true, true, ~0ull, 1>(), CRC<64, 0x42F0E1EBA9EA3693, ~0ull, true, true, ~0ull, 4>()
+		, CRC<64, 0x42F0E1EBA9EA3693, ~0ull, true, true, ~0ull, 8>(), CRC<64, 0x42F0E1EBA9EA3693, ~0ull, true, true, ~0ull, 16>());
+}
+
+TEST_CASE("crc-combine")  // NOLINT
+{
+	const auto data = TestHelpers::noise(3000);
+
+	const auto test = [&data](auto hash) -> void
+	{
+		using Hash = decltype(hash);
+		using Register = decltype(Hash::combine(0, 0, 0));
+		for (const size_t lenA : {0, 1, 3, 64, 1000})
+		{
+			for (const size_t lenB : {0, 1, 5, 16, 2000})
+			{
+				const Register crcA = Hash().addData(data.data(), lenA).finalize();
+				const Register crcB = Hash().addData((data.data() + lenA), lenB).finalize();
+				const Register crcAB = Hash().addData(data.data(), (lenA + lenB)).finalize();
+				REQUIRE(Hash::combine(crcA, crcB, lenB) == crcAB);
+			}
+		}
+	};
+
+	test(Chocobo1::CRC_16());
+	test(Chocobo1::CRC_32_BZIP2());
+	test(Chocobo1::CRC_64_XZ());
+
+	using namespace Chocobo1::Hash::CRC_NS;
+	test(CRC<8, 0x07, 0x00, false, false, 0x55>());  // CRC-8/I-432-1
+	test(CRC<24, 0x864CFB, 0xB704CE, false, false, 0>());  // CRC-24/OPENPGP
+	test(CRC<32, 0x04C11DB7, 0x12345678, true, false, 0x9ABCDEF0>());  // `RefIn != RefOut`
+	test(CRC<32, 0x04C11DB7, 0x12345678, false, true, 0x9ABCDEF0>());
+}
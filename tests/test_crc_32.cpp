@@ -12,6 +12,7 @@
 #include "../src/crc_32.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -51,3 +52,54 @@ TEST_CASE("crc-32")  // NOLINT
 
 	REQUIRE(0 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("crc-32-simd")  // NOLINT
+{
+	using Hash = Chocobo1::CRC_32;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("PCLMULQDQ", {&Features::pclmul, &Features::sse41}, []() -> void
+	{
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("38e4dbb5" == Hash().addData(s2.data(), 64).finalize().toString());
+		REQUIRE("9f5e59ef" == Hash().addData(s2.data(), 100).finalize().toString());
+		REQUIRE("1ed57bb9" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(999, 3), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
+
+TEST_CASE("crc-32-combine")  // NOLINT
+{
+	using Hash = Chocobo1::CRC_32;
+
+	const auto data = TestHelpers::noise(5000);
+
+	for (const size_t lenA : {0, 1, 3, 64, 1000})
+	{
+		for (const size_t lenB : {0, 1, 5, 16, 4000})
+		{
+			const uint32_t crcA = Hash().addData(data.data(), lenA).finalize();
+			const uint32_t crcB = Hash().addData((data.data() + lenA), lenB).finalize();
+			const uint32_t crcAB = Hash().addData(data.data(), (lenA + lenB)).finalize();
+			REQUIRE(Hash::combine(crcA, crcB, lenB) == crcAB);
+		}
+	}
+
+	const std::vector<uint8_t> s1(3 * 1024 * 1024 + 5, 'a');
+	const auto s1Hash = Hash().addData(s1.data(), s1.size()).finalize();
+	for (const unsigned int pieces : {0, 1, 2, 3, 8})
+		REQUIRE(Hash().addDataParallel({s1.data(), s1.size()}, pieces).finalize() == s1Hash);
+
+	REQUIRE(Hash().addDataParallel({data.data(), static_cast<size_t>(0)}, 4).finalize() == Hash().finalize());
+	REQUIRE(Hash().addDataParallel({data.data(), data.size()}, 4).finalize() == Hash().addData(data.data(), data.size()).finalize());
+
+	// continues from the data added before
+	REQUIRE(Hash().addData(data.data(), 50).addDataParallel({(data.data() + 50), 50}).finalize() == Hash().addData(data.data(), 100).finalize());
+	REQUIRE(Hash().addData(s1.data(), 1000).addDataParallel({(s1.data() + 1000), (s1.size() - 1000)}, 3).finalize() == s1Hash);
+}
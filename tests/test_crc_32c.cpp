@@ -0,0 +1,114 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2018 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/crc_32c.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+TEST_CASE("crc-32c")  // NOLINT
+{
+	using Hash = Chocobo1::CRC_32C;
+
+	// my own tests
+	REQUIRE(Hash() == Hash());
+	REQUIRE(Hash().addData("123").finalize() != Hash().finalize());
+
+	REQUIRE("00000000" == Hash().finalize().toString());
+
+	const char s11[] = "123456789";
+	REQUIRE("e3069283" == Hash().addData(s11, strlen(s11)).finalize().toString());
+
+	const char s12[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("22620404" == Hash().addData(s12, strlen(s12)).finalize().toString());
+
+	const char s13[] = "The quick brown fox jumps over the lazy dog.";
+	REQUIRE("190097b3" == Hash().addData(s13, strlen(s13)).finalize().toString());
+
+	const char s14[] = "The quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dogThe quick brown fox jumps over the lazy dog";
+	REQUIRE("d738cb83" == Hash().addData(s14, strlen(s14)).finalize().toString());
+
+	const std::vector<char> s15(65, 'a');
+	REQUIRE("37aeee33"
+			== Hash().addData(s15.data() + 1, s15.size() - 1).finalize().toString());
+
+	// https://tools.ietf.org/html/rfc3720#appendix-B.4
+	const unsigned char s16[32] = {0};
+	REQUIRE("8a9136aa" == Hash().addData(s16).finalize().toString());
+
+	const int s17[2] = {0};
+	const char s17_2[8] = {0};
+	REQUIRE(Hash().addData(Hash::Span<const int>(s17)).finalize().toString()
+			== Hash().addData(s17_2).finalize().toString());
+
+	const unsigned char s18[] = {0x00, 0x0A};
+	const auto s18_1 = Hash().addData(s18, 2).finalize().toArray();
+	const auto s18_2 = Hash().addData(s18).finalize().toArray();
+	REQUIRE(s18_1 == s18_2);
+
+	REQUIRE(0 == std::hash<Hash> {}(Hash().finalize()));
+}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("crc-32c-simd")  // NOLINT
+{
+	using Hash = Chocobo1::CRC_32C;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("SSE4.2", {&Features::sse42, &Features::pclmul}, []() -> void
+	{
+		const char s1[] = "123456789";
+		REQUIRE("e3069283" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("8dba050d" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+		const auto s3 = TestHelpers::noise(60000);
+		REQUIRE("6cc58d79" == Hash().addData(s3.data(), s3.size()).finalize().toString());
+	});
+
+	// also around the sizes handled as 3 streams
+	auto lengths = TestHelpers::lengths(1000, 3);
+	lengths.insert(lengths.end(), {24575, 24576, 24577, 25344, 49152, 50000, 59999});
+	TestHelpers::requireSimdMatchesPortable(lengths, [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
+
+TEST_CASE("crc-32c-combine")  // NOLINT
+{
+	using Hash = Chocobo1::CRC_32C;
+
+	const auto data = TestHelpers::noise(5000);
+
+	for (const size_t lenA : {0, 1, 3, 64, 1000})
+	{
+		for (const size_t lenB : {0, 1, 5, 16, 4000})
+		{
+			const uint32_t crcA = Hash().addData(data.data(), lenA).finalize();
+			const uint32_t crcB = Hash().addData((data.data() + lenA), lenB).finalize();
+			const uint32_t crcAB = Hash().addData(data.data(), (lenA + lenB)).finalize();
+			REQUIRE(Hash::combine(crcA, crcB, lenB) == crcAB);
+		}
+	}
+
+	const std::vector<uint8_t> s1(3 * 1024 * 1024 + 5, 'a');
+	const auto s1Hash = Hash().addData(s1.data(), s1.size()).finalize();
+	for (const unsigned int pieces : {0, 1, 2, 3, 8})
+		REQUIRE(Hash().addDataParallel({s1.data(), s1.size()}, pieces).finalize() == s1Hash);
+
+	// continues from the data added before
+	REQUIRE(Hash().addData(data.data(), 50).addDataParallel({(data.data() + 50), 50}).finalize() == Hash().addData(data.data(), 100).finalize());
+	REQUIRE(Hash().addData(s1.data(), 1000).addDataParallel({(s1.data() + 1000), (s1.size() - 1000)}, 3).finalize() == s1Hash);
+}
@@ -167,3 +167,59 @@ TEST_CASE("cshake-128")  // NOLINT
 	h19 = std::move(h19_2);
 	REQUIRE(h19.finalize().toVector() == Hash::BaseType(1344 / 8).finalize().toVector());
 }
+
+TEST_CASE("cshake-squeeze")  // NOLINT
+{
+	using Hash = Chocobo1::CSHAKE_256;
+
+	const uint8_t s1[4] = {0, 1, 2, 3};
+	for (const auto &customize : {std::string(), std::string("Email Signature")})
+	{
+		const auto expected = Hash(500, "", customize).addData(s1, ARRAY_LENGTH(s1)).finalize().toVector();
+
+		std::vector<uint8_t> out(expected.size());
+		Hash hash(0, "", customize);
+		hash.addData(s1, ARRAY_LENGTH(s1));
+		hash.squeeze({out.data(), 100}).squeeze({(out.data() + 100), 136}).squeeze({(out.data() + 236), 264});
+		REQUIRE(out == expected);
+	}
+}
+
+TEST_CASE("cshake-copy")  // NOLINT
+{
+	using Hash = Chocobo1::CSHAKE_128;
+
+	// copies are independent of the original
+	const uint8_t s1[4] = {0, 1, 2, 3};
+	Hash original(32, "", "Email Signature");
+	original.addData(s1, 2);
+
+	Hash copy = original;
+	Hash moved = Hash(original);
+	original.addData((s1 + 2), 2);
+
+	copy.addData((s1 + 2), 2);
+	moved.addData((s1 + 2), 2);
+	REQUIRE("c1c36925b6409a04f1b504fcbca9d82b4017277cb5ed2b2065fc1d3814d5aaf5" == copy.finalize().toString());
+	REQUIRE("c1c36925b6409a04f1b504fcbca9d82b4017277cb5ed2b2065fc1d3814d5aaf5" == moved.finalize().toString());
+	REQUIRE("c1c36925b6409a04f1b504fcbca9d82b4017277cb5ed2b2065fc1d3814d5aaf5" == original.finalize().toString());
+}
+
+TEST_CASE("cshake-prefix")  // NOLINT
+{
+	using Hash = Chocobo1::CSHAKE_256;
+
+	const uint8_t s1[4] = {0, 1, 2, 3};
+	for (const auto &customize : {std::string(), std::string("Email Signature")})
+	{
+		const Hash::Prefix prefix("", customize);
+		for (const int length : {32, 64, 200})
+		{
+			const auto expected = Hash(length, "", customize).addData(s1, ARRAY_LENGTH(s1)).finalize().toVector();
+			REQUIRE(expected == Hash::fromPrefix(prefix, length).addData(s1, ARRAY_LENGTH(s1)).finalize().toVector());
+
+			Hash hash = Hash::fromPrefix(prefix, length);
+			REQUIRE(hash == Hash(length, "", customize));
+		}
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/ed2k.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+TEST_CASE("ed2k")  // NOLINT
+{
+	using Hash = Chocobo1::ED2K;
+	const size_t chunkSize = 9728000;
+
+	const char s1[] = "";
+	REQUIRE("31d6cfe0d16ae931b73c59d7e0c089c0" == Hash().addData(s1, strlen(s1)).finalize().toString());
+
+	const char s2[] = "abc";
+	REQUIRE("a448017aaf21d8525fc10ae87aa6729d" == Hash().addData(s2, strlen(s2)).finalize().toString());
+
+	// size equal to the chunk size, with & without the empty chunk
+	const std::vector<uint8_t> s3(chunkSize, 0);
+	REQUIRE("d7def262a127cd79096a108e7a9fc138" == Hash().addData(s3.data(), s3.size()).finalize().toString());
+	REQUIRE("fc21d9af828f92a8df64beac3357425d" == Hash(true).addData(s3.data(), s3.size()).finalize().toString());
+
+	const auto s4 = TestHelpers::pattern(chunkSize + 1);
+	REQUIRE("07149b89efa248c03d7e2c5e734d2d88" == Hash().addData(s4.data(), s4.size()).finalize().toString());
+	REQUIRE("07149b89efa248c03d7e2c5e734d2d88" == Hash(true).addData(s4.data(), s4.size()).finalize().toString());
+
+	const auto s5 = TestHelpers::pattern(2 * chunkSize);
+	REQUIRE("90955b3afd7d14b68b672c584f88dd93" == Hash().addData(s5.data(), s5.size()).finalize().toString());
+	REQUIRE("b22937d7a5bb74050fb54037fe573649" == Hash(true).addData(s5.data(), s5.size()).finalize().toString());
+
+	// the whole chunks of a large input are split over the thread pool
+	const auto s6 = TestHelpers::pattern((3 * chunkSize) + 5);
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	REQUIRE("8673bb52bf751e8f9b0f05221df1f1cf" == Hash().addData(s6.data(), s6.size()).finalize().toString());
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+
+	// fed in pieces, the filled chunks are collected and hashed on the thread pool
+	Hash h7;
+	for (size_t i = 0; i < s6.size(); i += 1000000)
+		h7.addData((s6.data() + i), std::min<size_t>(1000000, (s6.size() - i)));
+	const Hash h7_2 = h7;
+	REQUIRE(h7_2 == h7);
+	REQUIRE("8673bb52bf751e8f9b0f05221df1f1cf" == h7.finalize().toString());
+	REQUIRE(h7_2 != h7);
+
+	Hash h8(true);
+	h8.addData(s5.data(), 1);
+	h8.addData((s5.data() + 1), (s5.size() - 1));
+	REQUIRE("b22937d7a5bb74050fb54037fe573649" == h8.finalize().toString());
+
+	h8.reset();
+	REQUIRE("31d6cfe0d16ae931b73c59d7e0c089c0" == h8.finalize().toString());
+
+	REQUIRE(0x31d6cfe0d16ae931 == std::hash<Hash> {}(Hash().finalize()));
+}
@@ -0,0 +1,160 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#ifndef CHOCOBO1_TEST_HELPERS_H
+#define CHOCOBO1_TEST_HELPERS_H
+
+#include "../src/x86_simd.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+
+namespace TestHelpers
+{
+	inline std::vector<uint8_t> pattern(const std::size_t length)
+	{
+		// input of the KangarooTwelve & BLAKE3 official test vectors: a repeating 251-byte pattern
+		std::vector<uint8_t> ret(length);
+		for (std::size_t i = 0; i < length; ++i)
+			ret[i] = static_cast<uint8_t>(i % 251);
+		return ret;
+	}
+
+	inline std::vector<uint8_t> noise(const std::size_t length)
+	{
+		// arbitrary bytes without a short period
+		std::vector<uint8_t> ret(length);
+		for (std::size_t i = 0; i < length; ++i)
+			ret[i] = static_cast<uint8_t>((i * 131) + 7);
+		return ret;
+	}
+
+	inline std::vector<std::size_t> lengths(const std::size_t last, const std::size_t step)
+	{
+		std::vector<std::size_t> ret;
+		for (std::size_t len = 0; len <= last; len += step)
+			ret.push_back(len);
+		return ret;
+	}
+
+	template <typename T>
+	std::string toHex(const T &bytes)
+	{
+		const char digits[] = "0123456789abcdef";
+		std::string ret;
+		for (const auto c : bytes)
+		{
+			ret += digits[(c >> 4) & 0xf];
+			ret += digits[c & 0xf];
+		}
+		return ret;
+	}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	class CpuFeaturesScope
+	{
+		// the detected features are restored on leaving the scope, also when a check fails
+		public:
+			using Feature = bool Chocobo1::Hash::CpuFeatures::*;
+
+			CpuFeaturesScope()
+				: m_detected(Chocobo1::Hash::cpuFeatures())
+			{
+			}
+
+			~CpuFeaturesScope()
+			{
+				Chocobo1::Hash::cpuFeaturesForTesting() = m_detected;
+			}
+
+			CpuFeaturesScope(const CpuFeaturesScope &) = delete;
+			CpuFeaturesScope& operator=(const CpuFeaturesScope &) = delete;
+
+			void portable()
+			{
+				Chocobo1::Hash::cpuFeaturesForTesting() = {};
+			}
+
+			void detected()
+			{
+				Chocobo1::Hash::cpuFeaturesForTesting() = m_detected;
+			}
+
+			bool only(const std::initializer_list<Feature> features)
+			{
+				// returns false when this CPU lacks any of `features`
+				Chocobo1::Hash::CpuFeatures enabled;
+				for (const auto feature : features)
+				{
+					if (!(m_detected.*feature))
+						return false;
+					enabled.*feature = true;
+				}
+				Chocobo1::Hash::cpuFeaturesForTesting() = enabled;
+				return true;
+			}
+
+		private:
+			const Chocobo1::Hash::CpuFeatures m_detected;
+	};
+
+	template <typename Func>
+	void requireSimdMatchesPortable(Func compute)
+	{
+		// the SIMD code paths of this CPU must match the portable code path
+		CpuFeaturesScope features;
+
+		features.portable();
+		const auto portable = compute();
+
+		features.detected();
+		const auto simd = compute();
+
+		REQUIRE(portable == simd);
+	}
+
+	template <typename Func>
+	void requireSimdMatchesPortable(const std::vector<std::size_t> &lengths, Func hash)
+	{
+		// `hash(data, split, length)` hashes `length` bytes of `data` in 2 pieces, the first one is `split` bytes
+		// `data` is unaligned
+		const auto data = noise(*std::max_element(lengths.begin(), lengths.end()) + 1);
+		for (const auto len : lengths)
+		{
+			const std::size_t split = len / 3;
+			requireSimdMatchesPortable([&]() { return hash((data.data() + 1), split, len); });
+		}
+	}
+
+	template <typename Func>
+	void checkKernel(const char *kernel, const std::initializer_list<CpuFeaturesScope::Feature> features, Func check)
+	{
+		// runs the known-answer checks with only `features` enabled, so the kernel using them is tested on its own
+		// a CPU without them is reported instead of passing silently
+		CpuFeaturesScope scope;
+		if (!scope.only(features))
+		{
+			WARN(kernel << " isn't supported by this CPU, its known-answer test didn't run");
+			return;
+		}
+		check();
+	}
+#endif
+}
+
+#endif  // CHOCOBO1_TEST_HELPERS_H
@@ -0,0 +1,122 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/kangaroo_twelve.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+static std::string ptnString(const size_t n)
+{
+	const auto v = TestHelpers::pattern(n);
+	return {v.begin(), v.end()};
+}
+
+
+TEST_CASE("kangaroo_twelve")  // NOLINT
+{
+	using Hash = Chocobo1::KangarooTwelve;
+
+	// official test suite in rfc
+	REQUIRE("1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5"
+			== Hash(32).finalize().toString());
+
+	REQUIRE("4269c056b8c82e48276038b6d292966cc07a3d4645272e31ff38508139eb0a71"
+			== Hash(64).finalize().toString().substr(64));
+
+	const char *ptnDigests[] =
+	{
+		"2bda92450e8b147f8a7cb629e784a058efca7cf7d8218e02d345dfaa65244a1f",
+		"6bf75fa2239198db4772e36478f8e19b0f371205f6a9a93a273f51df37122888",
+		"0c315ebcdedbf61426de7dcf8fb725d1e74675d7f5327a5067f367b108ecb67c",
+		"cb552e2ec77d9910701d578b457ddf772c12e322e4ee7fe417f92c758f0d59d0",
+		"8701045e22205345ff4dda05555cbb5c3af1a771c2b89baef37db43d9998b9fe",
+		"844d610933b1b9963cbdeb5ae3b6b05cc7cbd67ceedf883eb678a0a8e0371682"
+	};
+	for (size_t i = 0, len = 1; i < 6; ++i, len *= 17)
+	{
+		const auto s = TestHelpers::pattern(len);
+		REQUIRE(ptnDigests[i] == Hash(32).addData(s.data(), s.size()).finalize().toString());
+	}
+
+	const char *customDigests[] =
+	{
+		"fab658db63e94a246188bf7af69a133045f46ee984c56e3c3328caaf1aa1a583",
+		"d848c5068ced736f4462159b9867fd4c20b808acc3d5bc48e0b06ba0a3762ec4",
+		"c389e5009ae57120854c2e8c64670ac01358cf4c1baf89447a724234dc7ced74",
+		"75d2f86a2e644566726b4fbcfc5657b9dbcf070c7b0dca06450ab291d7443bcf"
+	};
+	for (size_t i = 0, len = 1; i < 4; ++i, len *= 41)
+	{
+		const std::vector<uint8_t> s(((1u << i) - 1), 0xFF);
+		REQUIRE(customDigests[i] == Hash(32, ptnString(len)).addData(s.data(), s.size()).finalize().toString());
+	}
+
+
+	// my own tests
+	REQUIRE(Hash() == Hash());
+	REQUIRE(Hash(32, "A") != Hash(32, "B"));
+	REQUIRE(Hash().addData("123").finalize() != Hash().finalize());
+
+	// around the chunk boundaries
+	const std::pair<size_t, const char *> s3[] =
+	{
+		{8191, "1b577636f723643e990cc7d6a659837436fd6a103626600eb8301cd1dbe553d6"},
+		{8192, "48f256f6772f9edfb6a8b661ec92dc93b95ebd05a08a17b39ae3490870c926c3"},
+		{8193, "bb66fe72eaea5179418d5295ee1344854d8ad7f3fa17efcb467ec152341284cf"},
+		{16384, "82778f7f7234c83352e76837b721fbdbb5270b88010d84fa5ab0b61ec8ce0956"},
+		{16385, "5f8d2b943922b451842b4e82740d02369e2d5f9f33c5123509a53b955fe177b2"}
+	};
+	for (const auto &test : s3)
+	{
+		const auto s = TestHelpers::pattern(test.first);
+		REQUIRE(test.second == Hash().addData(s.data(), s.size()).finalize().toString());
+
+		Hash hash;
+		for (size_t pos = 0, len = 1; pos < s.size(); pos += len, len = (len * 3) + 1)
+		{
+			len = std::min(len, (s.size() - pos));
+			hash.addData((s.data() + pos), len);
+		}
+		REQUIRE(test.second == hash.finalize().toString());
+	}
+
+	// large enough for the threaded path
+	const auto s4 = TestHelpers::noise((3 * 1024 * 1024) + 5);
+	REQUIRE("03e4bcea2b40921d365aa7c22941f998c67d77150187fd40d4435baa2c5234f591472d7d7071e586"
+			== Hash(40, "abc").addData(s4.data(), s4.size()).finalize().toString());
+
+	// 1 MiB pieces as the driver program reads them
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	Hash test4(40, "abc");
+	for (size_t pos = 0; pos < s4.size(); pos += (1024 * 1024))
+		test4.addData((s4.data() + pos), std::min<size_t>((1024 * 1024), (s4.size() - pos)));
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+	REQUIRE("03e4bcea2b40921d365aa7c22941f998c67d77150187fd40d4435baa2c5234f591472d7d7071e586"
+			== test4.finalize().toString());
+
+	Hash test5(32);
+	test5.addData(s4.data(), s4.size());
+	test5.reset();
+	REQUIRE(test5 == Hash(32));
+	REQUIRE("1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5"
+			== test5.finalize().toString());
+
+	const int s6[2] = {0};
+	const char s6_2[8] = {0};
+	REQUIRE(Hash().addData(Hash::Span<const int>(s6)).finalize().toString()
+			== Hash().addData(s6_2).finalize().toString());
+
+	REQUIRE(0x1ac2d450fc3b4205 == std::hash<Hash> {}(Hash().finalize()));
+}
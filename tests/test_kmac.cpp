@@ -0,0 +1,157 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/kmac.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+namespace
+{
+	struct Inputs
+	{
+		Inputs()
+		{
+			for (uint8_t i = 0; i < 32; ++i)
+				key.push_back(static_cast<uint8_t>(0x40 + i));
+			for (uint8_t i = 0; i < 4; ++i)
+				data4.push_back(i);
+			for (uint8_t i = 0; i < 200; ++i)
+				data200.push_back(i);
+		}
+
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> data4;
+		std::vector<uint8_t> data200;
+	};
+}
+
+
+TEST_CASE("kmac-128")  // NOLINT
+{
+	using Hash = Chocobo1::KMAC_128;
+	const Inputs in;
+
+	// official test suite from NIST
+	REQUIRE("e5780b0d3ea6f7d3a429c5706aa43a00fadbd7d49628839e3187243f456ee14e"
+			== Hash(32, in.key).addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("3b1fba963cd8b0b59e8c1a6d71888b7143651af8ba0a7070c0979e2811324aa5"
+			== Hash(32, in.key, "My Tagged Application").addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("1f5b4e6cca02209e0dcb5ca635b89a15e271ecc760071dfd805faa38f9729230"
+			== Hash(32, in.key, "My Tagged Application").addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash(32, in.key) == Hash(32, in.key));
+	REQUIRE(Hash(32, in.key) != Hash(32, in.data4));
+
+	// key longer than the rate
+	REQUIRE("39c89f921fa7bb8905dc57d3682a6653aef2b27b410d062aca22f786f6fdc65e"
+			== Hash(32, in.data200).addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+	// clones of the keyed state
+	const Hash keyed(32, in.key, "My Tagged Application");
+	Hash mac1 = keyed;
+	Hash mac2 = keyed;
+	REQUIRE("3b1fba963cd8b0b59e8c1a6d71888b7143651af8ba0a7070c0979e2811324aa5"
+			== mac1.addData(in.data4.data(), in.data4.size()).finalize().toString());
+	REQUIRE("1f5b4e6cca02209e0dcb5ca635b89a15e271ecc760071dfd805faa38f9729230"
+			== mac2.addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+	mac1.reset();
+	REQUIRE(mac1 == keyed);
+	REQUIRE("1f5b4e6cca02209e0dcb5ca635b89a15e271ecc760071dfd805faa38f9729230"
+			== mac1.addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+	REQUIRE(0xe5780b0d3ea6f7d3 == std::hash<Hash> {}(Hash(32, in.key).addData(in.data4.data(), in.data4.size()).finalize()));
+}
+
+TEST_CASE("kmac-256")  // NOLINT
+{
+	using Hash = Chocobo1::KMAC_256;
+	const Inputs in;
+
+	// official test suite from NIST
+	REQUIRE("20c570c31346f703c9ac36c61c03cb64c3970d0cfc787e9b79599d273a68d2f7f69d4cc3de9d104a351689f27cf6f5951f0103f33f4f24871024d9c27773a8dd"
+			== Hash(64, in.key, "My Tagged Application").addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("75358cf39e41494e949707927cee0af20a3ff553904c86b08f21cc414bcfd691589d27cf5e15369cbbff8b9a4c2eb17800855d0235ff635da82533ec6b759b69"
+			== Hash(64, in.key).addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+	REQUIRE("b58618f71f92e1d56c1b8c55ddd7cd188b97b4ca4d99831eb2699a837da2e4d970fbacfde50033aea585f1a2708510c32d07880801bd182898fe476876fc8965"
+			== Hash(64, in.key, "My Tagged Application").addData(in.data200.data(), in.data200.size()).finalize().toString());
+}
+
+TEST_CASE("kmacxof-128")  // NOLINT
+{
+	using Hash = Chocobo1::KMACXOF_128;
+	const Inputs in;
+
+	// official test suite from NIST
+	REQUIRE("cd83740bbd92ccc8cf032b1481a0f4460e7ca9dd12b08a0c4031178bacd6ec35"
+			== Hash(32, in.key).addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("31a44527b4ed9f5c6101d11de6d26f0620aa5c341def41299657fe9df1a3b16c"
+			== Hash(32, in.key, "My Tagged Application").addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("47026c7cd793084aa0283c253ef658490c0db61438b8326fe9bddf281b83ae0f"
+			== Hash(32, in.key, "My Tagged Application").addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+
+	// my own tests
+	// the output length isn't bound into the output
+	REQUIRE(Hash(16, in.key).addData(in.data4.data(), in.data4.size()).finalize().toString()
+			== Hash(32, in.key).addData(in.data4.data(), in.data4.size()).finalize().toString().substr(0, 32));
+}
+
+TEST_CASE("kmacxof-256")  // NOLINT
+{
+	using Hash = Chocobo1::KMACXOF_256;
+	const Inputs in;
+
+	// official test suite from NIST
+	REQUIRE("1755133f1534752aad0748f2c706fb5c784512cab835cd15676b16c0c6647fa96faa7af634a0bf8ff6df39374fa00fad9a39e322a7c92065a64eb1fb0801eb2b"
+			== Hash(64, in.key, "My Tagged Application").addData(in.data4.data(), in.data4.size()).finalize().toString());
+
+	REQUIRE("ff7b171f1e8a2b24683eed37830ee797538ba8dc563f6da1e667391a75edc02ca633079f81ce12a25f45615ec89972031d18337331d24ceb8f8ca8e6a19fd98b"
+			== Hash(64, in.key).addData(in.data200.data(), in.data200.size()).finalize().toString());
+
+	REQUIRE("d5be731c954ed7732846bb59dbe3a8e30f83e77a4bff4459f2f1c2b4ecebb8ce67ba01c62e8ab8578d2d499bd1bb276768781190020a306a97de281dcc30305d"
+			== Hash(64, in.key, "My Tagged Application").addData(in.data200.data(), in.data200.size()).finalize().toString());
+}
+
+TEST_CASE("kmacxof-squeeze")  // NOLINT
+{
+	using Hash = Chocobo1::KMACXOF_256;
+	const Inputs in;
+
+	// the output stream continues past the digest length given to the constructor
+	const auto expected = Hash(500, in.key, "My Tagged Application").addData(in.data200.data(), in.data200.size()).finalize().toVector();
+
+	std::vector<uint8_t> out(expected.size());
+	Hash hash(64, in.key, "My Tagged Application");
+	hash.addData(in.data200.data(), in.data200.size());
+	hash.squeeze({out.data(), 100}).squeeze({(out.data() + 100), 136}).squeeze({(out.data() + 236), 264});
+	REQUIRE(out == expected);
+	REQUIRE(TestHelpers::toHex(out).substr(0, 128)
+			== "d5be731c954ed7732846bb59dbe3a8e30f83e77a4bff4459f2f1c2b4ecebb8ce67ba01c62e8ab8578d2d499bd1bb276768781190020a306a97de281dcc30305d");
+
+	hash.reset();
+	REQUIRE(hash == Hash(64, in.key, "My Tagged Application"));
+	std::vector<uint8_t> out2(32);
+	hash.addData(in.data200.data(), in.data200.size()).squeeze(out2);
+	REQUIRE(out2 == std::vector<uint8_t>(expected.begin(), (expected.begin() + 32)));
+}
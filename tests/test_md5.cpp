@@ -12,6 +12,7 @@
 #include "../src/md5.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -78,3 +79,64 @@ TEST_CASE("md5")  // NOLINT
 
 	REQUIRE(0xd41d8cd98f00b204 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+TEST_CASE("md5-batch")  // NOLINT
+{
+	using Hash = Chocobo1::MD5;
+	using ByteSpan = Hash::Span<const uint8_t>;
+
+	const auto data = TestHelpers::noise(1000);
+
+	// lengths around the padding boundaries, more messages than lanes so that lanes get refilled
+	const size_t lengths[] = {0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 3, 500, 999, 200, 64, 0, 777, 17, 1000, 56};
+	std::vector<ByteSpan> messages;
+	for (const auto len : lengths)
+		messages.emplace_back(data.data(), len);
+
+	const auto digests = Hash::hashBatch(messages);
+	REQUIRE(digests.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests[i] == Hash().addData(messages[i]).finalize().toArray());
+
+	REQUIRE(Hash::hashBatch(std::vector<ByteSpan> {}).empty());
+	REQUIRE(Hash::hashBatch(std::vector<ByteSpan> {messages[10]}).front() == digests[10]);
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	TestHelpers::requireSimdMatchesPortable([&messages]() { return Hash::hashBatch(messages); });
+#endif
+}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("md5-batch-simd")  // NOLINT
+{
+	using Hash = Chocobo1::MD5;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	const auto check = []() -> void
+	{
+		// more messages than lanes
+		const auto data = TestHelpers::noise(1000);
+		const size_t lengths[] = {0, 1, 55, 56, 64, 1000, 0, 1, 55, 56, 64, 1000};
+		const char *expected[] =
+		{
+			"d41d8cd98f00b204e9800998ecf8427e",
+			"89e74e640b8c46257a29de0616794d5d",
+			"852e13533f66e414bbbbb3348de4f81f",
+			"98e8cb3457434649644b5fe9f4e5e4fa",
+			"bc00c8534af1e5aef0ede584d8ad5bc3",
+			"0b8ae90ded6089334e353eb2669ab5e6"
+		};
+
+		std::vector<Hash::Span<const uint8_t>> messages;
+		for (const auto len : lengths)
+			messages.emplace_back(data.data(), len);
+
+		const auto digests = Hash::hashBatch(messages);
+		REQUIRE(digests.size() == messages.size());
+		for (size_t i = 0; i < digests.size(); ++i)
+			REQUIRE(expected[i % 6] == TestHelpers::toHex(digests[i]));
+	};
+	TestHelpers::checkKernel("SSE2", {&Features::sse2}, check);
+	TestHelpers::checkKernel("AVX2", {&Features::avx2}, check);
+}
+#endif
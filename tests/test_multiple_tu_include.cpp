@@ -16,14 +16,23 @@
 #include "../src/blake1_384.h"
 #include "../src/blake1_512.h"
 #include "../src/blake2.h"
+#include "../src/blake2bp.h"
 #include "../src/blake2s.h"
+#include "../src/blake2sp.h"
+#include "../src/blake3.h"
+#include "../src/crc.h"
 #include "../src/crc_32.h"
+#include "../src/crc_32c.h"
 #include "../src/cshake.h"
+#include "../src/ed2k.h"
 #include "../src/fnv.h"
 #include "../src/has_160.h"
+#include "../src/kangaroo_twelve.h"
+#include "../src/kmac.h"
 #include "../src/md2.h"
 #include "../src/md4.h"
 #include "../src/md5.h"
+#include "../src/parallel_hash.h"
 #include "../src/ripemd_128.h"
 #include "../src/ripemd_160.h"
 #include "../src/ripemd_256.h"
@@ -39,5 +48,6 @@
 #include "../src/sha3.h"
 #include "../src/sm3.h"
 #include "../src/tiger.h"
+#include "../src/tth.h"
 #include "../src/tuple_hash.h"
 #include "../src/whirlpool.h"
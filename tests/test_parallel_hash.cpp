@@ -0,0 +1,145 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/parallel_hash.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+#include <stdexcept>
+
+
+#define ARRAY_LENGTH(a) (static_cast<int>(std::extent<decltype(a)>::value))
+
+
+TEST_CASE("parallel_hash-128")  // NOLINT
+{
+	using Hash = Chocobo1::ParallelHash_128;
+
+	// official test suite from NIST
+	const uint8_t s1[24] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+	REQUIRE("ba8dc1d1d979331d3f813603c67f72609ab5e44b94a0b8f9af46514454a2b4f5"
+			== Hash(32, 8).addData(s1, ARRAY_LENGTH(s1)).finalize().toString());
+
+	REQUIRE("fc484dcb3f84dceedc353438151bee58157d6efed0445a81f165e495795b7206"
+			== Hash(32, 8, "Parallel Data").addData(s1, ARRAY_LENGTH(s1)).finalize().toString());
+
+	const uint8_t s3[36] =
+	{
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B,
+		0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B
+	};
+	REQUIRE("4b5daf63e6ae90a063821b75442e0ba4c4010d0adc44222ecff5d155b36dc732"
+			== Hash(32, 12, "Parallel Data").addData(s3, ARRAY_LENGTH(s3)).finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash(32, 8192) == Hash(32, 8192));
+	REQUIRE(Hash(32, 8192).addData("123").finalize() != Hash(32, 8192).finalize());
+
+	REQUIRE("c7b32e3b071f7fb9c58054c93c2f35e0d8051a270d6c0136ef849232c96cd1c5"
+			== Hash(32, 8192).finalize().toString());
+
+	const char s4[] = "123";
+	REQUIRE("099a6999d823e2985b53bc14d89cd1581c63cc6ca7a82c2e1403afcf8736043d"
+			== Hash(32, 8192).addData(s4, strlen(s4)).finalize().toString());
+
+	// large enough for the threaded path, fed in uneven pieces
+	const auto s5 = TestHelpers::noise((3 * 1024 * 1024) + 5);
+	REQUIRE("7984ef317c5b5527d04b78bdab5f2f8d54a7ed94cbdca68ddf89523db8d28b4b"
+			== Hash(32, 8192).addData(s5.data(), s5.size()).finalize().toString());
+
+	Hash test5(32, 8192);
+	for (size_t pos = 0, len = 1; pos < s5.size(); pos += len, len = (len * 5) + 3)
+	{
+		len = std::min(len, (s5.size() - pos));
+		test5.addData((s5.data() + pos), len);
+	}
+	REQUIRE("7984ef317c5b5527d04b78bdab5f2f8d54a7ed94cbdca68ddf89523db8d28b4b"
+			== test5.finalize().toString());
+
+	// 1 MiB pieces as the driver program reads them, with a block size that doesn't divide them
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	Hash test5_2(32, 1000);
+	for (size_t pos = 0; pos < s5.size(); pos += (1024 * 1024))
+		test5_2.addData((s5.data() + pos), std::min<size_t>((1024 * 1024), (s5.size() - pos)));
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+
+	Hash test5_3(32, 1000);  // small pieces stay on the calling thread
+	for (size_t pos = 0; pos < s5.size(); pos += 100000)
+		test5_3.addData((s5.data() + pos), std::min<size_t>(100000, (s5.size() - pos)));
+	REQUIRE(test5_2.finalize().toString() == test5_3.finalize().toString());
+
+	test5.reset();
+	REQUIRE(test5 == Hash(32, 8192));
+	REQUIRE("c7b32e3b071f7fb9c58054c93c2f35e0d8051a270d6c0136ef849232c96cd1c5"
+			== test5.finalize().toString());
+
+	const int s6[2] = {0};
+	const char s6_2[8] = {0};
+	REQUIRE(Hash(32, 8).addData(Hash::Span<const int>(s6)).finalize().toString()
+			== Hash(32, 8).addData(s6_2).finalize().toString());
+
+	REQUIRE(0xc7b32e3b071f7fb9 == std::hash<Hash> {}(Hash(32, 8192).finalize()));
+}
+
+TEST_CASE("parallel_hash-256")  // NOLINT
+{
+	using Hash = Chocobo1::ParallelHash_256;
+
+	// official test suite from NIST
+	const uint8_t s1[24] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+	REQUIRE("bc1ef124da34495e948ead207dd9842235da432d2bbc54b4c110e64c451105531b7f2a3e0ce055c02805e7c2de1fb746af97a1dd01f43b824e31b87612410429"
+			== Hash(64, 8).addData(s1, ARRAY_LENGTH(s1)).finalize().toString());
+
+	REQUIRE("cdf15289b54f6212b4bc270528b49526006dd9b54e2b6add1ef6900dda3963bb33a72491f236969ca8afaea29c682d47a393c065b38e29fae651a2091c833110"
+			== Hash(64, 8, "Parallel Data").addData(s1, ARRAY_LENGTH(s1)).finalize().toString());
+
+	const uint8_t s3[36] =
+	{
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B,
+		0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B
+	};
+	REQUIRE("dd5a473bbb191b4051deef19d4b41628b44cc048271e613e71ba7e7633048409d1b6a89129d5c50b1d26e019ac07ad8f5fead21bd3351639644e0f2c2f873399"
+			== Hash(64, 12, "Parallel Data").addData(s3, ARRAY_LENGTH(s3)).finalize().toString());
+
+
+	// my own tests
+	const auto s4 = TestHelpers::noise((3 * 1024 * 1024) + 5);
+	REQUIRE("02aab61f7df318f5ea3c3071970ba3bce72da1c90555874e5e0ac9deae4a612e44fa580b86924d6296f2e1c5bee813d4b4340e80c6d0e5205e7998e6e688d99d"
+			== Hash(64, 1000, "abc").addData(s4.data(), s4.size()).finalize().toString());
+}
+
+TEST_CASE("parallel_hash-thread-pool")  // NOLINT
+{
+	// the pool shared by the tree hashes, with workers even on a single core CPU
+	Chocobo1::Hash::ThreadPool pool(3);
+
+	std::vector<int> done(64, 0);
+	pool.parallelFor(done.size(), [&done](const size_t i) { ++done[i]; });
+	REQUIRE(done == std::vector<int>(64, 1));
+
+	// every task still runs & finishes before an exception is passed on to the caller
+	for (const size_t throwing : {0, 1, 63})
+	{
+		std::fill(done.begin(), done.end(), 0);
+		REQUIRE_THROWS_AS(pool.parallelFor(done.size(), [&done, throwing](const size_t i)
+		{
+			++done[i];
+			if (i == throwing)
+				throw std::runtime_error("task failed");
+		}), std::runtime_error);
+		REQUIRE(done == std::vector<int>(64, 1));
+	}
+}
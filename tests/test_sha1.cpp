@@ -12,6 +12,7 @@
 #include "../src/sha1.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -97,3 +98,24 @@ TEST_CASE("sha1")  // NOLINT
 
 	REQUIRE(0xda39a3ee5e6b4b0d == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("sha1-simd")  // NOLINT
+{
+	using Hash = Chocobo1::SHA1;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("SHA extensions", {&Features::sha, &Features::sse41}, []() -> void
+	{
+		const char s1[] = "abc";
+		REQUIRE("a9993e364706816aba3e25717850c26c9cd0d89d" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("425b5f2d2d344f4f6467cda9065cdc840619dc2d" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(1000, 7), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
@@ -12,6 +12,7 @@
 #include "../src/sha2_224.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -97,3 +98,24 @@ TEST_CASE("sha2-224")  // NOLINT
 
 	REQUIRE(0xd14a028c2a3a2bc9 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("sha2-224-simd")  // NOLINT
+{
+	using Hash = Chocobo1::SHA2_224;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("SHA extensions", {&Features::sha, &Features::sse41}, []() -> void
+	{
+		const char s1[] = "abc";
+		REQUIRE("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("ab145b330355b6c708082c2e68b977f1a7ec493dbf7e72cb8f6ff542" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(1000, 7), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+}
+#endif
@@ -12,6 +12,7 @@
 #include "../src/sha2_256.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -97,3 +98,81 @@ TEST_CASE("sha2-256")  // NOLINT
 
 	REQUIRE(0xe3b0c44298fc1c14 == std::hash<Hash> {}(Hash().finalize()));
 }
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("sha2-256-simd")  // NOLINT
+{
+	using Hash = Chocobo1::SHA2_256;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("SHA extensions", {&Features::sha, &Features::sse41}, []() -> void
+	{
+		const char s1[] = "abc";
+		REQUIRE("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" == Hash().addData(s1, strlen(s1)).finalize().toString());
+		const auto s2 = TestHelpers::noise(1000);
+		REQUIRE("533b698850849b7908b20a22658f639c0b2a476f1791f85f50188287c31a9aba" == Hash().addData(s2.data(), s2.size()).finalize().toString());
+	});
+
+	TestHelpers::requireSimdMatchesPortable(TestHelpers::lengths(1000, 7), [](const uint8_t *data, const size_t split, const size_t len)
+	{
+		return Hash().addData(data, split).addData((data + split), (len - split)).finalize().toArray();
+	});
+
+	TestHelpers::checkKernel("AVX2 multi-buffer", {&Features::avx2}, []() -> void
+	{
+		// more messages than lanes
+		const auto data = TestHelpers::noise(1000);
+		const size_t lengths[] = {0, 1, 55, 56, 64, 100, 119, 1000, 3};
+		const char *expected[] =
+		{
+			"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+			"ca358758f6d27e6cf45272937977a748fd88391db679ceda7dc7bf1f005ee879",
+			"16ed9c4697ca11d5f6fb25ea7900252dd4cb97215d7f6d0b2bb3e2a86ac0ec72",
+			"939ada93b2fe1e9c596d767bb408567c83e253667f0b25e5be8e16f35f2cbac9",
+			"b337ba9b0c69c391364e985fdcb23a889887e59800832c92fbfa22b8a3c40304",
+			"b493defffa04821dbe4b757ed039293591680fd3f05a08182b145193205fcba0",
+			"9773fbac8194c3d789af101b49b6a26073076895ef6e0f658432849dd477a43f",
+			"533b698850849b7908b20a22658f639c0b2a476f1791f85f50188287c31a9aba",
+			"17aef23a39d753e713c203c152454d29fa8e39a98e83a69b39a5094dba9ae951"
+		};
+
+		std::vector<Hash::Span<const uint8_t>> messages;
+		for (const auto len : lengths)
+			messages.emplace_back(data.data(), len);
+
+		const auto digests = Hash::hashBatch(messages);
+		REQUIRE(digests.size() == messages.size());
+		for (size_t i = 0; i < digests.size(); ++i)
+			REQUIRE(expected[i] == TestHelpers::toHex(digests[i]));
+	});
+}
+#endif
+
+TEST_CASE("sha2-256-multiple-messages")  // NOLINT
+{
+	using Hash = Chocobo1::SHA2_256;
+
+	std::vector<std::vector<uint8_t>> messages;
+	for (size_t len = 0; len <= 300; ++len)
+		messages.emplace_back(len, static_cast<uint8_t>(len));
+	messages.emplace_back(10000, 'a');
+	messages.emplace_back(1, 'b');
+
+	std::vector<Hash::Span<const uint8_t>> spans;
+	for (const auto &message : messages)
+		spans.emplace_back(message.data(), message.size());
+
+	const auto results = Hash::hashBatch(spans);
+	REQUIRE(results.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(results[i] == Hash().addData(messages[i].data(), messages[i].size()).finalize().toArray());
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	// force the multi-buffer code path on CPUs with the SHA extensions
+	TestHelpers::CpuFeaturesScope features;
+	Chocobo1::Hash::cpuFeaturesForTesting().sha = false;
+	REQUIRE(Hash::hashBatch(spans) == results);
+#endif
+
+	REQUIRE(Hash::hashBatch({}).empty());
+}
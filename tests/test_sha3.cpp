@@ -12,6 +12,7 @@
 #include "../src/sha3.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -330,3 +331,63 @@ TEST_CASE("sha3-224")  // NOLINT
 	h19 = std::move(h19_2);
 	REQUIRE(h19.finalize().toVector() == Hash::BaseType(224 / 8).finalize().toVector());
 }
+
+TEST_CASE("sha3-batch")  // NOLINT
+{
+	using Hash = Chocobo1::SHA3_256;
+	using ByteSpan = Hash::Span<const uint8_t>;
+
+	const auto data = TestHelpers::noise(1000);
+
+	// lengths around the block size (136 bytes), 9 messages so that the last group isn't full
+	const size_t lengths[] = {0, 1, 135, 136, 137, 272, 500, 1000, 3};
+	std::vector<ByteSpan> messages;
+	for (const auto len : lengths)
+		messages.emplace_back(data.data(), len);
+
+	const auto digests = Hash::hashBatch(messages);
+	REQUIRE(digests.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests[i] == Hash().addData(messages[i]).finalize().toVector());
+
+	REQUIRE(Hash::hashBatch(std::vector<ByteSpan> {}).empty());
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	TestHelpers::requireSimdMatchesPortable([&messages]() { return Chocobo1::SHA3_512::hashBatch(messages); });
+#endif
+}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("sha3-batch-simd")  // NOLINT
+{
+	using Hash = Chocobo1::SHA3_256;
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("AVX2", {&Features::avx2}, []() -> void
+	{
+		// 2 full groups of 4 lanes
+		const auto data = TestHelpers::noise(1000);
+		const size_t lengths[] = {0, 3, 135, 136, 1000, 136, 3, 0};
+		const char *expected[] =
+		{
+			"a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a",
+			"2023f70d8e6b8cd9b95ee07a6d99af127d79c09c667ec3b3338fd349c6ea5d15",
+			"bdc755cae86f329a1d266ef115046bc6d7ba1a5ed5c2cf0f0e1fd5828b2346cd",
+			"f2c64612923dca6e03bfc83134e18c3af83e9e71f1fa28c4638780f418d57f44",
+			"1f19041e8a66f1d749359a829c16367fd45629eaff0f5568f9566df5bcbd1f3b",
+			"f2c64612923dca6e03bfc83134e18c3af83e9e71f1fa28c4638780f418d57f44",
+			"2023f70d8e6b8cd9b95ee07a6d99af127d79c09c667ec3b3338fd349c6ea5d15",
+			"a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a"
+		};
+
+		std::vector<Hash::Span<const uint8_t>> messages;
+		for (const auto len : lengths)
+			messages.emplace_back(data.data(), len);
+
+		const auto digests = Hash::hashBatch(messages);
+		REQUIRE(digests.size() == messages.size());
+		for (size_t i = 0; i < digests.size(); ++i)
+			REQUIRE(expected[i] == TestHelpers::toHex(digests[i]));
+	});
+}
+#endif
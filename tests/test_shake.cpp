@@ -12,7 +12,9 @@
 #include "../src/sha3.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
+#include <algorithm>
 #include <cstring>
 
 
@@ -164,3 +166,95 @@ TEST_CASE("shake-128")  // NOLINT
 	h18 = std::move(h18_2);
 	REQUIRE(h18.finalize().toVector() == Hash::BaseType(512).finalize().toVector());
 }
+
+TEST_CASE("shake-batch")  // NOLINT
+{
+	using Hash = Chocobo1::SHAKE_128;
+	using ByteSpan = Hash::Span<const uint8_t>;
+
+	const auto data = TestHelpers::noise(1000);
+
+	// lengths around the block size (168 bytes), the digests need more than 1 block of output
+	const size_t lengths[] = {0, 167, 168, 169, 1000, 336, 5, 700};
+	std::vector<ByteSpan> messages;
+	for (const auto len : lengths)
+		messages.emplace_back(data.data(), len);
+
+	const auto digests = Hash::hashBatch(400, messages);
+	REQUIRE(digests.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests[i] == Hash(400).addData(messages[i]).finalize().toVector());
+}
+
+TEST_CASE("shake-squeeze")  // NOLINT
+{
+	using Hash = Chocobo1::SHAKE_128;
+
+	const char s1[] = "The quick brown fox jumps over the lazy dog";
+	const auto expected = Hash(1000).addData(s1, strlen(s1)).finalize().toVector();
+
+	// uneven pieces that cross the block boundaries (168 bytes)
+	std::vector<uint8_t> out(expected.size());
+	Hash hash(0);
+	hash.addData(s1, strlen(s1));
+	for (size_t pos = 0, len = 1; pos < out.size(); pos += len, len = (len * 3) + 1)
+	{
+		len = std::min(len, (out.size() - pos));
+		hash.squeeze({(out.data() + pos), len});
+	}
+	REQUIRE(out == expected);
+
+	// `finalize()` continues the same output stream
+	uint8_t first[10] = {};
+	Hash hash2(990);
+	hash2.addData(s1, strlen(s1)).squeeze(first);
+	REQUIRE(std::equal(first, (first + 10), expected.begin()));
+	REQUIRE(std::equal(expected.begin() + 10, expected.end(), hash2.finalize().toVector().begin()));
+
+	hash2.reset();
+	uint8_t empty[200] = {};
+	hash2.squeeze(empty);
+	REQUIRE(std::equal(empty, (empty + 200), Hash(200).finalize().toVector().begin()));
+}
+
+TEST_CASE("turboshake-128")  // NOLINT
+{
+	using Hash = Chocobo1::TurboSHAKE_128;
+
+	// official test suite in rfc
+	REQUIRE("1e415f1c5983aff2169217277d17bb538cd945a397ddec541f1ce41af2c1b74c"
+			== Hash(32).finalize().toString());
+
+	const auto s2 = TestHelpers::pattern(17 * 17);
+	REQUIRE("96c77c279e0126f7fc07c9b07f5cdae1e0be60bdbe10620040e75d7223a624d2"
+			== Hash(32).addData(s2.data(), s2.size()).finalize().toString());
+
+	const auto s3 = TestHelpers::pattern(17 * 17 * 17);
+	REQUIRE("7b0fcc5dcc6d856035ecd2a17ec2d999c8b90574bbf209fc8069e3cf00ccad39"
+			== Chocobo1::Hash::SHA3_NS::Keccak<(1344 / 8), 0x0B, 12>(32).addData(s3.data(), s3.size()).finalize().toString());
+
+
+	// my own tests
+	REQUIRE(Hash(32).finalize().toVector() != Chocobo1::SHAKE_128(32).finalize().toVector());
+
+	const size_t lengths[] = {0, 167, 168, 169, 1000};
+	std::vector<Hash::Span<const uint8_t>> messages;
+	for (const auto len : lengths)
+		messages.emplace_back(s3.data(), len);
+	const auto digests = Hash::hashBatch(200, messages);
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests[i] == Hash(200).addData(messages[i]).finalize().toVector());
+}
+
+TEST_CASE("turboshake-256")  // NOLINT
+{
+	using Hash = Chocobo1::TurboSHAKE_256;
+
+	// official test suite in rfc
+	REQUIRE("367a329dafea871c7802ec67f905ae13c57695dc2c6663c61035f59a18f8e7db11edc0e12e91ea60eb6b32df06dd7f002fbafabb6e13ec1cc20d995547600db0"
+			== Hash(64).finalize().toString());
+
+	const auto s2 = TestHelpers::pattern(17 * 17);
+	REQUIRE("66b810db8e90780424c0847372fdc95710882fde31c6df75beb9d4cd9305cfcae35e7b83e8b7e6eb4b78605880116316fe2c078a09b94ad7b8213c0a738b65c0"
+			== Hash(64).addData(s2.data(), s2.size()).finalize().toString());
+}
@@ -12,6 +12,7 @@
 #include "../src/siphash.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -61,3 +62,139 @@ TEST_CASE("siphash")  // NOLINT
 
 	REQUIRE(0x1e924b9d737700d7 == std::hash<Hash> {}(Hash(key2).finalize()));
 }
+
+TEST_CASE("siphash-variants")  // NOLINT
+{
+	// official test vectors from https://github.com/veorq/SipHash/blob/master/vectors.h, in reverse byte order
+	// key = 00 01 02 ..., message = 00 01 02 ...
+	std::vector<unsigned char> key(16);
+	std::vector<unsigned char> message(63);
+	for (size_t i = 0; i < message.size(); ++i)
+		message[i] = static_cast<unsigned char>(i);
+	for (size_t i = 0; i < key.size(); ++i)
+		key[i] = static_cast<unsigned char>(i);
+	const Chocobo1::SipHash::Span<const unsigned char> key16(key.data(), 16);
+	const Chocobo1::SipHash::Span<const unsigned char> key8(key.data(), 8);
+
+	REQUIRE("726fdb47dd0e0e31" == Chocobo1::SipHash(key16).finalize().toString());
+	REQUIRE("930255c71472f66de6a825ba047f81a3" == Chocobo1::SipHash_128(key16).finalize().toString());
+	REQUIRE("3982f01fa64ab8c053c1dbd8beebf1a1" == Chocobo1::SipHash_128(key16).addData(message.data(), 7).finalize().toString());
+	REQUIRE("d9c3cf970fec087e11a8b03399e99354" == Chocobo1::SipHash_128(key16).addData(message.data(), 15).finalize().toString());
+	REQUIRE("7cbd3f979a063e504a83502f77d15051" == Chocobo1::SipHash_128(key16).addData(message.data(), 63).finalize().toString());
+
+	REQUIRE("5b9f35a9" == Chocobo1::HalfSipHash(key8).finalize().toString());
+	REQUIRE("8f84b8d0" == Chocobo1::HalfSipHash(key8).addData(message.data(), 8).finalize().toString());
+	REQUIRE("744aea59" == Chocobo1::HalfSipHash(key8).addData(message.data(), 63).finalize().toString());
+	REQUIRE("c83cb8b9591f8d21" == Chocobo1::HalfSipHash_64(key8).finalize().toString());
+	REQUIRE("02c9814ecb0b7d21" == Chocobo1::HalfSipHash_64(key8).addData(message.data(), 15).finalize().toString());
+	REQUIRE("876032bf713ca62e" == Chocobo1::HalfSipHash_64(key8).addData(message.data(), 63).finalize().toString());
+
+	// reduced rounds variants, computed with the reference implementation
+	REQUIRE("abac0158050fc4dc" == Chocobo1::SipHash_1_3(key16).finalize().toString());
+	REQUIRE("2370dd1f8c21d1bc" == Chocobo1::SipHash_1_3(key16).addData(message.data(), 31).finalize().toString());
+	REQUIRE("ad6052a70a6b9f076f42fe4ee300584c" == Chocobo1::SipHash_1_3_128(key16).addData(message.data(), 63).finalize().toString());
+	REQUIRE("d0257b04" == Chocobo1::HalfSipHash_1_3(key8).addData(message.data(), 15).finalize().toString());
+	REQUIRE("5f7aec1d31a8cd3d" == Chocobo1::HalfSipHash_1_3_64(key8).addData(message.data(), 8).finalize().toString());
+
+	// my own tests
+	const unsigned char key2[16] = {};
+	const char s1[] = "The quick brown fox jumps over the lazy dog";
+	REQUIRE("8df676d3d00c451e" == Chocobo1::SipHash_1_3(key2).addData(s1, strlen(s1)).finalize().toString());
+	REQUIRE("b21a59dfb51b3fc0257fc576e85c8cdf" == Chocobo1::SipHash_128(key2).addData(s1, strlen(s1)).finalize().toString());
+	const unsigned char key3[8] = {};
+	REQUIRE("615d28ed" == Chocobo1::HalfSipHash(key3).addData(s1, strlen(s1)).finalize().toString());
+	REQUIRE("14e46f986c0ef231" == Chocobo1::HalfSipHash_64(key3).addData(s1, strlen(s1)).finalize().toString());
+
+	REQUIRE(0x930255c71472f66d == std::hash<Chocobo1::SipHash_128> {}(Chocobo1::SipHash_128(key16).finalize()));
+	REQUIRE(0x5b9f35a9 == std::hash<Chocobo1::HalfSipHash> {}(Chocobo1::HalfSipHash(key8).finalize()));
+}
+
+TEST_CASE("siphash-oneshot")  // NOLINT
+{
+	const auto data = TestHelpers::noise(100);
+	const unsigned char key[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+	const Chocobo1::SipHash::Span<const unsigned char> key8(key, 8);
+
+	// the one-shot functions must match the streaming interface
+	for (size_t len = 0; len <= data.size(); ++len)
+	{
+		const Chocobo1::SipHash::Span<const unsigned char> message(data.data(), len);
+		REQUIRE(Chocobo1::SipHash::hash(key, message) == Chocobo1::SipHash(key).addData(message).finalize().toArray());
+		REQUIRE(Chocobo1::SipHash_1_3::hash(key, message) == Chocobo1::SipHash_1_3(key).addData(message).finalize().toArray());
+		REQUIRE(Chocobo1::SipHash_128::hash(key, message) == Chocobo1::SipHash_128(key).addData(message).finalize().toArray());
+		REQUIRE(Chocobo1::HalfSipHash::hash(key8, message) == Chocobo1::HalfSipHash(key8).addData(message).finalize().toArray());
+		REQUIRE(Chocobo1::HalfSipHash_64::hash(key8, message) == Chocobo1::HalfSipHash_64(key8).addData(message).finalize().toArray());
+	}
+
+	REQUIRE(Chocobo1::SipHash::hash(key, {}) == Chocobo1::SipHash(key).finalize().toArray());
+}
+
+TEST_CASE("siphash-batch")  // NOLINT
+{
+	const auto data = TestHelpers::noise(100);
+	const unsigned char key[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+
+	// equal & mixed lengths in the same group of lanes, plus a group that isn't filled
+	using ByteSpan = Chocobo1::SipHash::Span<const uint8_t>;
+	const size_t lengths[] = {8, 8, 8, 8, 0, 1, 7, 100, 16, 15, 17, 32, 24, 31, 9, 3, 40};
+	std::vector<ByteSpan> messages;
+	for (size_t i = 0; i < (sizeof(lengths) / sizeof(lengths[0])); ++i)
+		messages.emplace_back((data.data() + i), lengths[i]);
+
+	const auto digests = Chocobo1::SipHash::hashBatch(key, messages);
+	REQUIRE(digests.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests[i] == Chocobo1::SipHash(key).addData(messages[i]).finalize().toArray());
+
+	const auto digests128 = Chocobo1::SipHash_1_3_128::hashBatch(key, messages);
+	REQUIRE(digests128.size() == messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		REQUIRE(digests128[i] == Chocobo1::SipHash_1_3_128(key).addData(messages[i]).finalize().toArray());
+
+	REQUIRE(Chocobo1::SipHash::hashBatch(key, std::vector<ByteSpan> {}).empty());
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+	TestHelpers::requireSimdMatchesPortable([&key, &messages]() { return Chocobo1::SipHash::hashBatch(key, messages); });
+	TestHelpers::requireSimdMatchesPortable([&key, &messages]() { return Chocobo1::SipHash_1_3_128::hashBatch(key, messages); });
+#endif
+}
+
+#if (USE_X86_SIMD_CHOCOBO1_HASH == 1)
+TEST_CASE("siphash-batch-simd")  // NOLINT
+{
+	using Features = Chocobo1::Hash::CpuFeatures;
+
+	TestHelpers::checkKernel("AVX2", {&Features::avx2}, []() -> void
+	{
+		// reference test vectors: message 00 01 02 ..., 2 full groups of 4 lanes
+		unsigned char key[16] = {};
+		std::vector<uint8_t> data(63);
+		for (size_t i = 0; i < data.size(); ++i)
+		{
+			if (i < sizeof(key))
+				key[i] = static_cast<unsigned char>(i);
+			data[i] = static_cast<uint8_t>(i);
+		}
+
+		const size_t lengths[] = {0, 1, 7, 8, 15, 16, 31, 63};
+		const char *expected[] = {"726fdb47dd0e0e31", "74f839c593dc67fd", "ab0200f58b01d137", "93f5f5799a932462"
+			, "a129ca6149be45e5", "3f2acc7f57c29bdb", "32d892fad841c342", "958a324ceb064572"};
+		const char *expected128[] = {"930255c71472f66de6a825ba047f81a3", "45fc229b1159763444af996bd8c187da", "3982f01fa64ab8c053c1dbd8beebf1a1", "b49714f364e2830f61f55862baa9623b"
+			, "d9c3cf970fec087e11a8b03399e99354", "77052385bf1533fdbb54b067caa4e26e", "353dc4524fde2317fcfa233218b03929", "7cbd3f979a063e504a83502f77d15051"};
+
+		std::vector<Chocobo1::SipHash::Span<const uint8_t>> messages;
+		for (const auto len : lengths)
+			messages.emplace_back(data.data(), len);
+
+		const auto digests = Chocobo1::SipHash::hashBatch(key, messages);
+		const auto digests128 = Chocobo1::SipHash_128::hashBatch(key, messages);
+		REQUIRE(digests.size() == messages.size());
+		REQUIRE(digests128.size() == messages.size());
+		for (size_t i = 0; i < messages.size(); ++i)
+		{
+			REQUIRE(expected[i] == TestHelpers::toHex(digests[i]));
+			REQUIRE(expected128[i] == TestHelpers::toHex(digests128[i]));
+		}
+	});
+}
+#endif
@@ -0,0 +1,130 @@
+/*
+ *  Chocobo1/Hash
+ *
+ *   Copyright 2017-2021 by Mike Tzou (Chocobo1)
+ *     https://github.com/Chocobo1/Hash
+ *
+ *   Licensed under GNU General Public License 3 or later.
+ *
+ *  @license GPL3 <https://www.gnu.org/licenses/gpl-3.0-standalone.html>
+ */
+
+#include "../src/tth.h"
+
+#include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
+
+#include <cstring>
+
+
+static std::vector<std::vector<Chocobo1::TTH::ResultArrayType>> naiveTree(const std::vector<uint8_t> &data)
+{
+	// builds the whole tree level by level
+	using Tiger = Chocobo1::Tiger1_192;
+	const uint8_t leafPrefix[1] = {0x00};
+	const uint8_t nodePrefix[1] = {0x01};
+
+	std::vector<std::vector<Chocobo1::TTH::ResultArrayType>> ret(1);
+	for (size_t i = 0; (i < data.size()) || (i == 0); i += 1024)
+		ret[0].emplace_back(Tiger().addData(leafPrefix).addData((data.data() + i), std::min<size_t>(1024, (data.size() - i))).finalize().toArray());
+
+	while (ret.back().size() > 1)
+	{
+		const auto level = ret.back();
+		std::vector<Chocobo1::TTH::ResultArrayType> above;
+		for (size_t i = 0; i < level.size(); i += 2)
+		{
+			if ((i + 1) == level.size())
+				above.emplace_back(level[i]);
+			else
+				above.emplace_back(Tiger().addData(nodePrefix).addData(level[i].data(), 24).addData(level[i + 1].data(), 24).finalize().toArray());
+		}
+		ret.emplace_back(above);
+	}
+	return ret;
+}
+
+
+TEST_CASE("tth")  // NOLINT
+{
+	using Hash = Chocobo1::TTH;
+
+	// test vectors from tthsum
+	const char s1[] = "";
+	REQUIRE("5d9ed00a030e638bdb753a6a24fb900e5a63b8e73e6c25b6" == Hash().addData(s1, strlen(s1)).finalize().toString());
+
+	const uint8_t s2[] = {0x00};
+	REQUIRE("aabbcca084acecd0511d1f6232a17bfaefa441b2982e5548" == Hash().addData(s2).finalize().toString());
+
+	const std::vector<char> s3(1024, 'A');
+	REQUIRE("5fbd0e62ad016d596b77d1d28883b94fed78ecbaf4640914" == Hash().addData(s3.data(), s3.size()).finalize().toString());
+
+	const std::vector<char> s4(1025, 'A');
+	REQUIRE("7e591c1cd8f2e6121fdbcd8071ba279626b771642d10a3db" == Hash().addData(s4.data(), s4.size()).finalize().toString());
+
+	// odd number of nodes on various levels
+	for (const size_t len : {2048, 3072, 5000, 7 * 1024, 9 * 1024, 17 * 1024, 100000})
+	{
+		const auto s = TestHelpers::pattern(len);
+		REQUIRE(naiveTree(s).back().front() == Hash().addData(s.data(), s.size()).finalize().toArray());
+	}
+
+	// large enough to be hashed on threads, fed at once & in 1 MiB pieces as the driver program reads them
+	const auto s5 = TestHelpers::pattern((3 * 1024 * 1024) + 1000);
+	const auto s5Tree = naiveTree(s5);
+	REQUIRE(s5Tree.back().front() == Hash().addData(s5.data(), s5.size()).finalize().toArray());
+
+	const uint64_t queuedTasks = Chocobo1::Hash::threadPool().queuedTasksForTesting();
+	Hash h5(1);
+	for (size_t i = 0; i < s5.size(); i += (1024 * 1024))
+		h5.addData((s5.data() + i), std::min<size_t>((1024 * 1024), (s5.size() - i)));
+	REQUIRE(Chocobo1::Hash::threadPool().queuedTasksForTesting() > queuedTasks);
+	REQUIRE(h5.finalize().toTree() == decltype(s5Tree)((s5Tree.begin() + 1), s5Tree.end()));
+
+	// small pieces stay on the calling thread
+	Hash h6;
+	for (size_t i = 0; i < s5.size(); i += 1000)
+		h6.addData((s5.data() + i), std::min<size_t>(1000, (s5.size() - i)));
+	REQUIRE(s5Tree.back().front() == h6.finalize().toArray());
+
+	h6.reset();
+	REQUIRE("5d9ed00a030e638bdb753a6a24fb900e5a63b8e73e6c25b6" == h6.finalize().toString());
+	REQUIRE(h6.toTree().empty());
+
+	REQUIRE(0x5d9ed00a030e638b == std::hash<Hash> {}(Hash().finalize()));
+}
+
+TEST_CASE("tth-tree")  // NOLINT
+{
+	using Hash = Chocobo1::TTH;
+
+	for (const size_t len : {0, 1000, 1024, 5000, 9 * 1024, 100000, 1024 * 1024})
+	{
+		const auto s = TestHelpers::pattern(len);
+		const auto expected = naiveTree(s);
+
+		for (const int level : {0, 1, 3, 30})
+		{
+			const auto tree = Hash(level).addData(s.data(), s.size()).finalize().toTree();
+			const size_t first = std::min<size_t>(static_cast<size_t>(level), (expected.size() - 1));
+			REQUIRE(tree == decltype(expected)((expected.begin() + static_cast<std::ptrdiff_t>(first)), expected.end()));
+		}
+	}
+
+	// the exported tree is part of the state
+	REQUIRE(Hash(1) == Hash(1));
+	REQUIRE(Hash(1) != Hash(2));
+	const auto s2 = TestHelpers::pattern(5000);
+	REQUIRE(Hash(0).addData(s2.data(), s2.size()).finalize() != Hash(1).addData(s2.data(), s2.size()).finalize());
+
+	// a range covered by 1 node of the exported level is verified on its own
+	const auto s = TestHelpers::pattern(100000);
+	const auto tree = Hash(4).addData(s.data(), s.size()).finalize().toTree();
+	const size_t nodeSize = 1024 * 16;
+	REQUIRE(tree.front().size() == 7);
+	for (size_t i = 0; i < tree.front().size(); ++i)
+	{
+		const size_t len = std::min<size_t>(nodeSize, (s.size() - (i * nodeSize)));
+		REQUIRE(tree.front()[i] == Hash().addData((s.data() + (i * nodeSize)), len).finalize().toArray());
+	}
+}
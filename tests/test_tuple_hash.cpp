@@ -12,6 +12,7 @@
 #include "../src/tuple_hash.h"
 
 #include "catch2/single_include/catch2/catch.hpp"
+#include "test_helpers.h"
 
 #include <cstring>
 
@@ -163,3 +164,59 @@ TEST_CASE("tuple_hash-128")  // NOLINT
 	h19 = std::move(h19_2);
 	REQUIRE(h19.finalize().toVector() == Hash::BaseType(512).finalize().toVector());
 }
+
+TEST_CASE("tuple_hash-prefix")  // NOLINT
+{
+	using Hash = Chocobo1::TupleHash_128;
+
+	const Hash::Prefix prefix("My Tuple App");
+
+	const uint8_t s1_1[3] = {0, 1, 2};
+	const uint8_t s1_2[6] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15};
+	REQUIRE("75cdb20ff4db1154e841d758e24160c54bae86eb8c13e7f5f40eb35588e96dfb"
+			== Hash::fromPrefix(prefix, 32).nextData(s1_1, ARRAY_LENGTH(s1_1)).nextData(s1_2, ARRAY_LENGTH(s1_2)).finalize().toString());
+
+	for (const int length : {16, 64})
+	{
+		REQUIRE(Hash(length, "My Tuple App").nextData(s1_1, ARRAY_LENGTH(s1_1)).finalize().toVector()
+				== Hash::fromPrefix(prefix, length).nextData(s1_1, ARRAY_LENGTH(s1_1)).finalize().toVector());
+	}
+}
+
+TEST_CASE("tuple_hash-element")  // NOLINT
+{
+	using Hash = Chocobo1::TupleHash_256;
+
+	const uint8_t s1_1[3] = {0, 1, 2};
+	const uint8_t s1_2[6] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15};
+	const uint8_t s1_3[9] = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28};
+
+	// elements streamed in pieces match whole elements
+	Hash hash(64, "My Tuple App");
+	hash.nextData(s1_1, ARRAY_LENGTH(s1_1));
+	hash.beginElement(ARRAY_LENGTH(s1_2)).addElementData(s1_2, 1).addElementData((s1_2 + 1), 5).endElement();
+	hash.beginElement(ARRAY_LENGTH(s1_3));
+	for (int i = 0; i < ARRAY_LENGTH(s1_3); ++i)
+		hash.addElementData((s1_3 + i), 1);
+	hash.endElement();
+	REQUIRE("45000be63f9b6bfd89f54717670f69a9bc763591a4f05c50d68891a744bcc6e7d6d5b5e82c018da999ed35b0bb49c9678e526abd8e85c13ed254021db9e790ce"
+			== hash.finalize().toString());
+
+	// an open element is part of the state
+	Hash open(32);
+	open.beginElement(ARRAY_LENGTH(s1_2));
+	REQUIRE(open != Hash(open).addElementData(s1_2, 1));
+	REQUIRE(open == Hash(open));
+
+	// an empty element
+	REQUIRE(Hash(32).beginElement(0).endElement().finalize().toString()
+			== Hash(32).nextData(s1_1, 0).finalize().toString());
+
+	const auto s2 = TestHelpers::noise(100000);
+	Hash hash2(32);
+	hash2.beginElement(s2.size());
+	for (size_t pos = 0; pos < s2.size(); pos += 4096)
+		hash2.addElementData((s2.data() + pos), std::min<size_t>(4096, (s2.size() - pos)));
+	REQUIRE(Hash(32).nextData(s2.data(), s2.size()).finalize().toVector()
+			== hash2.endElement().finalize().toVector());
+}